@@ -0,0 +1,868 @@
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(WIN32) && !defined(_WIN32)
+    #include <sys/resource.h>
+#endif
+
+#include "MazeGrid.hpp"
+#include "MazeFaceMask.hpp"
+#include "MazeWallGrid.hpp"
+#include "MazeOccupancyPyramid.hpp"
+#include "MazeGeneratorDFS.hpp"
+#include "MazeGeneratorRD.hpp"
+#include "MazeGeneratorEller.hpp"
+#include "MazeGeneratorWilson.hpp"
+#include "MazeGeneratorKruskal.hpp"
+#include "MazeGeneratorPrim.hpp"
+#include "MazeGeneratorBinaryTree.hpp"
+#include "MazeGeneratorSidewinder.hpp"
+#include "MazeGeneratorHuntAndKill.hpp"
+#include "MazeGeneratorGrowingTree.hpp"
+#include "MazeGeneratorRegistry.hpp"
+#include "MazeWorld.hpp"
+
+//Benchmark for maze array storage and generators
+//Compares bit-packed MazeGrid against plain bool** array using the same access patterns as generators and renderer
+
+//Reference bool** array, same layout that was used by generators before MazeGrid
+class BoolArray
+{
+    public:
+        BoolArray(unsigned int size)
+        {
+            this->size = size;
+            fields = new bool*[size];
+
+            for (unsigned int i = 0; i < size; i++)
+                fields[i] = new bool[size]();
+        }
+
+        void fill(bool value)
+        {
+            for (unsigned int i = 0; i < size; i++)
+                for (unsigned int j = 0; j < size; j++)
+                    fields[i][j] = value;
+        }
+
+        ~BoolArray()
+        {
+            for (unsigned int i = 0; i < size; i++)
+                delete [] fields[i];
+
+            delete [] fields;
+        }
+
+        bool get(unsigned int row, unsigned int column) const { return fields[row][column]; }
+        void set(unsigned int row, unsigned int column, bool value) { fields[row][column] = value; }
+
+    private:
+        bool** fields;
+        unsigned int size;
+};
+
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//Reference recursive DFS that was used before iterative one
+//Every call adds four directions to shared list and goes through whole shuffled list, so it slows down with every carved field
+class RecursiveDFS
+{
+    public:
+        RecursiveDFS(unsigned int size)
+        {
+            this->size = size + 2;
+            engine.seed(1);
+            grid.allocate(this->size, this->size);
+        }
+
+        void generate()
+        {
+            grid.fill(true);
+
+            unsigned int x = 3 + engine() % (size - 5), y = 3 + engine() % (size - 5);
+
+            grid.set(x, y, false);
+            addPath(x, y - 1);
+        }
+
+    private:
+        unsigned int size;
+        MazeGrid grid;
+        std::mt19937 engine;
+        std::vector<int> directions;
+
+        void addPath(unsigned int x, unsigned int y)
+        {
+            if (x >= size - 1 || x < 1 || y < 1 || y >= size - 1 || !grid.get(x, y))
+                return;
+
+            if (!grid.get(x - 1, y) + !grid.get(x + 1, y) + !grid.get(x, y - 1) + !grid.get(x, y + 1) > 1)
+                return;
+
+            grid.set(x, y, false);
+
+            directions.push_back(1);
+            directions.push_back(2);
+            directions.push_back(3);
+            directions.push_back(4);
+
+            std::shuffle(directions.begin(), directions.end(), engine);
+
+            for (unsigned int i = 0; i < directions.size(); i++)
+            {
+                switch (directions[i])
+                {
+                    case 1: addPath(x, y - 1); break;
+                    case 2: addPath(x, y + 1); break;
+                    case 3: addPath(x - 1, y); break;
+                    case 4: addPath(x + 1, y); break;
+                }
+            }
+        }
+};
+
+//Fill array with random fields so reads are not trivially predictable
+template <typename Array>
+void fillRandom(Array& array, unsigned int size)
+{
+    std::mt19937 engine(1);
+
+    for (unsigned int i = 0; i < size; i++)
+        for (unsigned int j = 0; j < size; j++)
+            array.set(i, j, engine() & 1);
+}
+
+//Random walk reading four neighbours on every step (DFS pattern)
+template <typename Array>
+double benchmarkNeighbourReads(const Array& array, unsigned int size, unsigned int steps, unsigned int& checksum)
+{
+    std::mt19937 engine(2);
+    unsigned int x = size / 2, y = size / 2;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < steps; i++)
+    {
+        checksum += array.get(x - 1, y) + array.get(x + 1, y) + array.get(x, y - 1) + array.get(x, y + 1);
+
+        switch (engine() & 3)
+        {
+            case 0: x = (x > 1) ? x - 1 : x + 1; break;
+            case 1: x = (x < size - 2) ? x + 1 : x - 1; break;
+            case 2: y = (y > 1) ? y - 1 : y + 1; break;
+            case 3: y = (y < size - 2) ? y + 1 : y - 1; break;
+        }
+    }
+
+    return elapsedMilliseconds(start) * 1000000.0 / steps;
+}
+
+//Horizontal and vertical wall lines (RD pattern)
+template <typename Array>
+double benchmarkWallWrites(Array& array, unsigned int size, unsigned int lines)
+{
+    std::mt19937 engine(3);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < lines; i++)
+    {
+        unsigned int index = engine() % size;
+
+        if (i & 1)
+        {
+            for (unsigned int j = 0; j < size; j++)
+                array.set(index, j, true);
+        }
+        else
+        {
+            for (unsigned int j = 0; j < size; j++)
+                array.set(j, index, true);
+        }
+    }
+
+    return elapsedMilliseconds(start) * 1000000.0 / (double(lines) * size);
+}
+
+//30x30 window around random camera positions with four neighbour checks on empty fields (renderer pattern)
+template <typename Array>
+double benchmarkRenderWindow(const Array& array, unsigned int size, unsigned int frames, unsigned int& checksum)
+{
+    std::mt19937 engine(4);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int frame = 0; frame < frames; frame++)
+    {
+        unsigned int cameraX = 16 + engine() % (size - 32);
+        unsigned int cameraZ = 16 + engine() % (size - 32);
+
+        for (unsigned int i = cameraZ - 15; i < cameraZ + 15; i++)
+        {
+            for (unsigned int j = cameraX - 15; j < cameraX + 15; j++)
+            {
+                if (array.get(i, j))
+                    continue;
+
+                checksum += array.get(i, j - 1) + array.get(i, j + 1) + array.get(i - 1, j) + array.get(i + 1, j);
+            }
+        }
+    }
+
+    return elapsedMilliseconds(start) * 1000000.0 / (double(frames) * 900);
+}
+
+//Setting whole array before generation
+template <typename Array>
+double benchmarkClear(Array& array, unsigned int size)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    array.fill(true);
+
+    return elapsedMilliseconds(start) * 1000000.0 / (double(size) * size);
+}
+
+//Allocating and freeing whole array
+double benchmarkAllocation(unsigned int size, bool packed)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    if (packed)
+    {
+        MazeGrid mazeGrid;
+        mazeGrid.allocate(size, size);
+    }
+    else
+    {
+        BoolArray boolArray(size);
+    }
+
+    return elapsedMilliseconds(start);
+}
+
+void benchmarkStorage(unsigned int size)
+{
+    unsigned int checksum = 0;
+
+    BoolArray boolArray(size);
+    MazeGrid mazeGrid;
+    mazeGrid.allocate(size, size);
+
+    fillRandom(boolArray, size);
+    fillRandom(mazeGrid, size);
+
+    std::cout << "Storage, size " << size << std::endl;
+    std::cout << "  memory:          bool** " << (double(size) * size) / (1024 * 1024) << " MiB, MazeGrid "
+              << mazeGrid.getMemoryUsage() / (1024.0 * 1024.0) << " MiB" << std::endl;
+    std::cout << "  allocate/free:   bool** " << benchmarkAllocation(size, false) << " ms, MazeGrid "
+              << benchmarkAllocation(size, true) << " ms" << std::endl;
+    std::cout << "  neighbour reads: bool** " << benchmarkNeighbourReads(boolArray, size, 10000000, checksum) << " ns/step, MazeGrid "
+              << benchmarkNeighbourReads(mazeGrid, size, 10000000, checksum) << " ns/step" << std::endl;
+    std::cout << "  wall writes:     bool** " << benchmarkWallWrites(boolArray, size, 200) << " ns/field, MazeGrid "
+              << benchmarkWallWrites(mazeGrid, size, 200) << " ns/field" << std::endl;
+    std::cout << "  render window:   bool** " << benchmarkRenderWindow(boolArray, size, 20000, checksum) << " ns/field, MazeGrid "
+              << benchmarkRenderWindow(mazeGrid.getView(), size, 20000, checksum) << " ns/field" << std::endl;
+    std::cout << "  clear:           bool** " << benchmarkClear(boolArray, size) << " ns/field, MazeGrid "
+              << benchmarkClear(mazeGrid, size) << " ns/field" << std::endl;
+    std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+//Count of minor page faults of this process (0 when it's not available)
+long getPageFaults()
+{
+    #if !defined(WIN32) && !defined(_WIN32)
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        return usage.ru_minflt;
+    #else
+        return 0;
+    #endif
+}
+
+void benchmarkGenerator(std::string name, MazeGenerator* generator)
+{
+    long pageFaults = getPageFaults();
+    auto start = std::chrono::steady_clock::now();
+
+    generator->generateMaze();
+
+    double time = elapsedMilliseconds(start);
+    unsigned int size = generator->getMazeSize();
+
+    pageFaults = getPageFaults() - pageFaults;
+
+    std::cout << name << " " << size << ": " << time << " ms, " << (double(size) * size) / (time * 1000.0) << " Mfields/s, "
+              << generator->getMemoryUsage() / (1024.0 * 1024.0) << " MiB, " << pageFaults << " page faults";
+
+    if (generator->getPeakStackSize() != 0)
+    {
+        std::cout << ", peak stack " << generator->getPeakStackSize();
+    }
+
+    generator->compactArray();
+
+    if (!generator->getStorageStatistics().empty())
+    {
+        std::cout << ", " << generator->getStorageStatistics() << " (" << generator->getMemoryUsage() / (1024.0 * 1024.0) << " MiB after compacting)";
+    }
+
+    std::cout << std::endl;
+
+    delete generator;
+}
+
+//Checksum of whole maze and its start and exit
+std::uint64_t getMazeChecksum(MazeGenerator& generator)
+{
+    MazeGridView mazeArray = generator.getMazeArray();
+    std::uint64_t checksum = generator.getStartX() ^ (generator.getStartY() << 16) ^ (generator.getEndX() << 32) ^ (generator.getEndY() << 48);
+
+    for (std::uint64_t row = 0; row < mazeArray.getRows(); row++)
+    {
+        for (std::uint64_t column = 0; column < mazeArray.getColumns(); column += 64)
+        {
+            checksum = (checksum ^ mazeArray.getBits(row, column)) * 1099511628211ULL;
+        }
+    }
+
+    return checksum;
+}
+
+//Parallel generator with growing count of threads, maze must be the same for every count
+template <typename Generator>
+void benchmarkParallel(std::string name, unsigned int size)
+{
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::uint64_t firstChecksum = 0;
+    double firstTime = 0.0;
+
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        Generator generator(size, "benchmark");
+        generator.setThreads(threads);
+
+        auto start = std::chrono::steady_clock::now();
+
+        generator.generateMaze();
+
+        double time = elapsedMilliseconds(start);
+        std::uint64_t checksum = getMazeChecksum(generator);
+
+        if (threads == 1)
+        {
+            firstChecksum = checksum;
+            firstTime = time;
+        }
+
+        std::cout << name << " parallel " << generator.getMazeSize() << " with " << threads << " threads: " << time << " ms, "
+                  << (double(generator.getMazeSize()) * generator.getMazeSize()) / (time * 1000.0) << " Mfields/s, speedup "
+                  << firstTime / time << (checksum == firstChecksum ? "" : ", MAZE DIFFERS") << std::endl;
+
+        if (threads < maxThreads && threads * 2 > maxThreads)
+        {
+            threads = maxThreads / 2;
+        }
+    }
+}
+
+//Generation in steps with given budget against one-shot generation, maze must be the same
+//First step also clears maze array, so it's reported separately from latency of other steps
+template <typename Generator>
+void benchmarkSliced(std::string name, unsigned int size, std::uint64_t budget)
+{
+    Generator oneShotGenerator(size, "benchmark");
+
+    auto start = std::chrono::steady_clock::now();
+    oneShotGenerator.generateMaze();
+    double oneShotTime = elapsedMilliseconds(start);
+
+    Generator generator(size, "benchmark");
+    std::vector<double> stepTimes;
+    bool finished = false;
+
+    while (!finished)
+    {
+        start = std::chrono::steady_clock::now();
+        finished = generator.step(budget);
+        stepTimes.push_back(elapsedMilliseconds(start) * 1000.0);
+    }
+
+    double firstStep = stepTimes.front();
+    double totalTime = 0.0;
+
+    for (double time : stepTimes)
+    {
+        totalTime += time;
+    }
+
+    stepTimes.erase(stepTimes.begin());
+    std::sort(stepTimes.begin(), stepTimes.end());
+
+    std::cout << name << " sliced " << generator.getMazeSize() << ", budget " << budget << ": " << stepTimes.size() + 1 << " steps, first "
+              << firstStep << " us, median " << (stepTimes.empty() ? 0.0 : stepTimes[stepTimes.size() / 2]) << " us, p99 "
+              << (stepTimes.empty() ? 0.0 : stepTimes[stepTimes.size() * 99 / 100]) << " us, max " << (stepTimes.empty() ? 0.0 : stepTimes.back())
+              << " us, total " << totalTime / 1000.0 << " ms (one-shot " << oneShotTime << " ms)"
+              << (getMazeChecksum(generator) == getMazeChecksum(oneShotGenerator) ? "" : ", MAZE DIFFERS") << std::endl;
+}
+
+//Eller maze streamed to row sink, nothing is stored so memory stays the same for any count of rows
+void benchmarkEllerStream(unsigned int columns, std::uint64_t rows)
+{
+    MazeGeneratorEller generator(columns, "benchmark");
+    std::uint64_t walls = 0;
+    std::uint64_t rowWords = (generator.getMazeSize() + 63) / 64;
+
+    generator.setRowSink([&walls, rowWords](std::uint64_t, const std::uint64_t* words) {
+        for (std::uint64_t i = 0; i < rowWords; i++)
+        {
+            walls += std::bitset<64>(words[i]).count();
+        }
+    }, rows);
+
+    auto start = std::chrono::steady_clock::now();
+
+    generator.generateMaze();
+
+    double time = elapsedMilliseconds(start);
+
+    std::cout << "Eller stream " << generator.getMazeSize() << "x" << rows << ": " << time << " ms, "
+              << (double(generator.getMazeSize()) * rows) / (time * 1000.0) << " Mfields/s, " << walls << " walls" << std::endl;
+}
+
+//Render window on generated RD maze stored as bits, as walls and as compressed tiles
+void benchmarkStorageTypes(unsigned int size)
+{
+    unsigned int checksum = 0;
+
+    MazeGeneratorRD bitsGenerator(size, "benchmark");
+    MazeGeneratorRD wallsGenerator(size, "benchmark");
+    MazeGeneratorRD compressedGenerator(size, "benchmark");
+    wallsGenerator.setStorage(MazeGenerator::Storage::WALLS);
+    compressedGenerator.setStorage(MazeGenerator::Storage::COMPRESSED);
+
+    bitsGenerator.generateMaze();
+    wallsGenerator.generateMaze();
+    compressedGenerator.generateMaze();
+
+    auto start = std::chrono::steady_clock::now();
+
+    compressedGenerator.compactArray();
+
+    double compressTime = elapsedMilliseconds(start);
+
+    std::cout << "RD maze storage, size " << bitsGenerator.getMazeSize() << std::endl;
+    std::cout << "  memory:          BITS " << bitsGenerator.getMemoryUsage() / (1024.0 * 1024.0) << " MiB, WALLS "
+              << wallsGenerator.getMemoryUsage() / (1024.0 * 1024.0) << " MiB, COMPRESSED "
+              << compressedGenerator.getMemoryUsage() / (1024.0 * 1024.0) << " MiB (compressed in " << compressTime << " ms)" << std::endl;
+    std::cout << "  render window:   BITS " << benchmarkRenderWindow(bitsGenerator.getMazeArray(), bitsGenerator.getMazeSize(), 20000, checksum)
+              << " ns/field, WALLS " << benchmarkRenderWindow(wallsGenerator.getMazeArray(), wallsGenerator.getMazeSize(), 20000, checksum)
+              << " ns/field, COMPRESSED " << benchmarkRenderWindow(compressedGenerator.getMazeArray(), compressedGenerator.getMazeSize(), 20000, checksum)
+              << " ns/field" << std::endl;
+    std::cout << "  COMPRESSED:      " << compressedGenerator.getStorageStatistics() << std::endl;
+    std::cout << "  (checksum " << checksum << ")" << std::endl;
+}
+
+//30x30 window reading face masks of empty fields (renderer pattern with MazeFaceMask)
+double benchmarkFaceWindow(const MazeGridView& array, const MazeWallGrid* wallGrid, const MazeFaceMask& faceMask, unsigned int size, unsigned int frames, unsigned int& checksum)
+{
+    std::mt19937 engine(4);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int frame = 0; frame < frames; frame++)
+    {
+        unsigned int cameraX = 16 + engine() % (size - 32);
+        unsigned int cameraZ = 16 + engine() % (size - 32);
+
+        for (unsigned int i = cameraZ - 15; i < cameraZ + 15; i++)
+        {
+            for (unsigned int j = cameraX - 15; j < cameraX + 15; j++)
+            {
+                if (wallGrid != nullptr ? wallGrid->isWall(i, j) : array.get(i, j))
+                    continue;
+
+                checksum += faceMask.get(i, j);
+            }
+        }
+    }
+
+    return elapsedMilliseconds(start) * 1000000.0 / (double(frames) * 900);
+}
+
+//Building face masks with one thread and all threads, then render window with derived and precomputed faces
+void benchmarkFaceMask(unsigned int size)
+{
+    unsigned int checksum = 0;
+
+    MazeGeneratorRD generator(size, "benchmark");
+    generator.generateMaze();
+
+    MazeGridView mazeArray = generator.getMazeArray();
+    MazeFaceMask derivedMask(mazeArray, generator.getEndY(), generator.getEndX());
+    MazeFaceMask faceMask(mazeArray, generator.getEndY(), generator.getEndX());
+
+    auto start = std::chrono::steady_clock::now();
+    faceMask.build(1);
+    double singleTime = elapsedMilliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    faceMask.build();
+    double parallelTime = elapsedMilliseconds(start);
+
+    std::cout << "Face mask, size " << generator.getMazeSize() << std::endl;
+    std::cout << "  build:           1 thread " << singleTime << " ms, all threads " << parallelTime << " ms, "
+              << faceMask.getMemoryUsage() / (1024.0 * 1024.0) << " MiB" << std::endl;
+    std::cout << "  render window:   derived " << benchmarkFaceWindow(mazeArray, nullptr, derivedMask, generator.getMazeSize(), 20000, checksum)
+              << " ns/field, precomputed " << benchmarkFaceWindow(mazeArray, nullptr, faceMask, generator.getMazeSize(), 20000, checksum)
+              << " ns/field (checksum " << checksum << ")" << std::endl;
+
+    //WALLS storage read through generic storage reads and through wall bits like renderer does
+    MazeGeneratorRD wallsGenerator(size, "benchmark");
+    wallsGenerator.setStorage(MazeGenerator::Storage::WALLS);
+    wallsGenerator.generateMaze();
+
+    MazeGridView wallsArray = wallsGenerator.getMazeArray();
+    MazeFaceMask genericMask(wallsArray, wallsGenerator.getEndY(), wallsGenerator.getEndX());
+    MazeFaceMask wallsMask(wallsArray, wallsGenerator.getEndY(), wallsGenerator.getEndX(), wallsGenerator.getWallGrid());
+
+    std::cout << "  WALLS window:    storage reads " << benchmarkFaceWindow(wallsArray, nullptr, genericMask, wallsGenerator.getMazeSize(), 20000, checksum)
+              << " ns/field, wall bits " << benchmarkFaceWindow(wallsArray, wallsGenerator.getWallGrid(), wallsMask, wallsGenerator.getMazeSize(), 20000, checksum)
+              << " ns/field (checksum " << checksum << ")" << std::endl;
+}
+
+//Wall counts of random square regions from pyramid and from scanning maze array
+void benchmarkPyramid(unsigned int size, unsigned int regionSize)
+{
+    MazeGeneratorRD generator(size, "benchmark");
+    generator.generateMaze();
+
+    MazeGridView mazeArray = generator.getMazeArray();
+    MazeOccupancyPyramid pyramid(mazeArray);
+
+    auto start = std::chrono::steady_clock::now();
+    pyramid.build();
+    double buildTime = elapsedMilliseconds(start);
+
+    unsigned int queries = 1000;
+    std::uint64_t pyramidWalls = 0, scannedWalls = 0;
+    std::mt19937 engine(5);
+
+    start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < queries; i++)
+    {
+        std::uint64_t row = engine() % (size - regionSize), column = engine() % (size - regionSize);
+        pyramidWalls += pyramid.countWalls(row, column, row + regionSize, column + regionSize);
+    }
+
+    double pyramidTime = elapsedMilliseconds(start);
+
+    engine.seed(5);
+    start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < queries; i++)
+    {
+        std::uint64_t row = engine() % (size - regionSize), column = engine() % (size - regionSize);
+
+        for (std::uint64_t j = row; j < row + regionSize; j++)
+            for (std::uint64_t k = column; k < column + regionSize; k++)
+                scannedWalls += mazeArray.get(j, k);
+    }
+
+    double scanTime = elapsedMilliseconds(start);
+
+    std::cout << "Occupancy pyramid, size " << generator.getMazeSize() << ", region " << regionSize << "x" << regionSize << ": build "
+              << buildTime << " ms, " << pyramid.getMemoryUsage() / (1024.0 * 1024.0) << " MiB, query " << pyramidTime * 1000.0 / queries
+              << " us, scan " << scanTime * 1000.0 / queries << " us" << (pyramidWalls == scannedWalls ? "" : " (counts differ)") << std::endl;
+}
+
+//Old recursive DFS against iterative DFS generator
+void benchmarkDFS(unsigned int size)
+{
+    RecursiveDFS recursiveDFS(size);
+
+    auto start = std::chrono::steady_clock::now();
+    recursiveDFS.generate();
+    double recursiveTime = elapsedMilliseconds(start);
+
+    MazeGeneratorDFS generator(size, "benchmark");
+
+    start = std::chrono::steady_clock::now();
+    generator.generateMaze();
+    double iterativeTime = elapsedMilliseconds(start);
+
+    std::cout << "DFS " << size + 2 << ": recursive " << recursiveTime << " ms, iterative " << iterativeTime << " ms ("
+              << recursiveTime / iterativeTime << "x)" << std::endl;
+}
+
+//Generation and render window scan with layout this benchmark was compiled with
+//Run benchmark built for every layout (glmaze_benchmark_row_major, _tiled, _morton) to compare them
+void benchmarkLayout(unsigned int size)
+{
+    unsigned int checksum = 0;
+
+    MazeGeneratorRD generator(size, "benchmark");
+
+    auto start = std::chrono::steady_clock::now();
+
+    generator.generateMaze();
+
+    std::cout << "RD " << generator.getMazeSize() << ": " << elapsedMilliseconds(start) << " ms, render window "
+              << benchmarkRenderWindow(generator.getMazeArray(), generator.getMazeSize(), 20000, checksum) << " ns/field (checksum "
+              << checksum << ")" << std::endl;
+}
+
+//Endless world walked straight (new chunks in one direction) and in square loop around start (chunks evicted and generated again)
+void benchmarkWorld(std::uint64_t steps, std::uint64_t radius)
+{
+    std::uint64_t center = MazeWorld::WORLD_SIZE / 2;
+    MazeWorld straightWorld(MazeRandom::hashSeed("benchmark"), radius);
+
+    auto start = std::chrono::steady_clock::now();
+    straightWorld.update(center, center);
+    double startTime = elapsedMilliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+
+    for (std::uint64_t i = 1; i <= steps; i++)
+    {
+        straightWorld.update(center, center + i * MazeWorld::CHUNK_FIELDS);
+    }
+
+    double straightTime = elapsedMilliseconds(start);
+    std::uint64_t straightChunks = straightWorld.getGeneratedChunks();
+
+    MazeWorld loopWorld(MazeRandom::hashSeed("benchmark"), radius);
+    std::uint64_t side = 4 * radius + 4; //Square is big enough to evict chunks of its other side
+    std::uint64_t row = center, column = center;
+
+    start = std::chrono::steady_clock::now();
+
+    for (std::uint64_t i = 0; i < steps; i++)
+    {
+        switch ((i / side) % 4)
+        {
+            case 0: column += MazeWorld::CHUNK_FIELDS; break;
+            case 1: row += MazeWorld::CHUNK_FIELDS; break;
+            case 2: column -= MazeWorld::CHUNK_FIELDS; break;
+            default: row -= MazeWorld::CHUNK_FIELDS; break;
+        }
+
+        loopWorld.update(row, column);
+    }
+
+    double loopTime = elapsedMilliseconds(start);
+
+    std::cout << "Endless world, radius " << radius << ": start " << startTime << " ms, walk " << steps << " chunks "
+              << straightTime << " ms (" << straightTime * 1000.0 / straightChunks << " us/chunk), loop " << loopTime << " ms ("
+              << loopTime * 1000.0 / loopWorld.getGeneratedChunks() << " us/chunk), " << straightWorld.getMemoryUsage() / 1024.0
+              << " KiB, " << straightWorld.getStatistics() << std::endl;
+}
+
+//Every registered generator against its registry estimates (speeds in registry are measured by this section), then AUTO selections
+void benchmarkRegistry(unsigned int size)
+{
+    MazeGeneratorRegistry& registry = MazeGeneratorRegistry::getInstance();
+    const char* storageNames[] = { "BITS", "WALLS", "CHUNKED", "COMPRESSED" };
+
+    for (const MazeGeneratorInfo& info : registry.getGenerators())
+    {
+        if (info.hasCapability(MazeGeneratorInfo::ENDLESS))
+        {
+            continue;
+        }
+
+        for (MazeGenerator::Storage storage : { MazeGenerator::Storage::BITS, MazeGenerator::Storage::WALLS })
+        {
+            if (storage == MazeGenerator::Storage::WALLS && !info.hasCapability(MazeGeneratorInfo::WALL_STORAGE))
+            {
+                continue;
+            }
+
+            MazeGenerator* generator = registry.create(info.name, size, "benchmark");
+            generator->setStorage(storage);
+
+            auto start = std::chrono::steady_clock::now();
+            generator->generateMaze();
+            double time = elapsedMilliseconds(start);
+
+            double fields = double(generator->getMazeSize()) * generator->getMazeSize();
+            double estimate = storage == MazeGenerator::Storage::WALLS ? info.megaFieldsPerSecondWalls : info.megaFieldsPerSecond;
+
+            std::cout << info.name << " " << storageNames[storage] << " " << generator->getMazeSize() << ": " << fields / (time * 1000.0)
+                      << " Mfields/s (estimate " << estimate << "), " << generator->getMemoryUsage() / (1024.0 * 1024.0) << " MiB array (estimate "
+                      << info.estimateMemory(size, storage) / (1024.0 * 1024.0) << " MiB with generator data)" << std::endl;
+
+            delete generator;
+        }
+    }
+
+    for (std::uint64_t selectSize : { 1000, 100000 })
+    {
+        for (std::uint64_t budget : { 0, 1024 * 1024 * 1024, 512 * 1024 * 1024 })
+        {
+            for (unsigned int threads : { 1, 8 })
+            {
+                MazeGenerator::Storage storage;
+                const MazeGeneratorInfo* info = registry.selectFastest(selectSize, std::uint64_t(budget), threads, storage);
+
+                std::cout << "AUTO " << selectSize << ", budget " << budget / (1024 * 1024) << " MiB, " << threads << " threads: "
+                          << info->name << " (" << storageNames[storage] << ", " << info->estimateMemory(selectSize, storage) / (1024.0 * 1024.0)
+                          << " MiB)" << std::endl;
+            }
+        }
+    }
+}
+
+//Sections can be selected by command line arguments: storage, layout, generators, world, sliced, registry, parallel (all of them are run by default)
+//Section huge generates 100000 size mazes (needs about 1.2 GiB of memory), it's run only when it's selected
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> sections(argv + 1, argv + argc);
+
+    auto isSelected = [&sections](std::string section) {
+        return sections.empty() || std::find(sections.begin(), sections.end(), section) != sections.end();
+    };
+
+    std::cout << "Maze array layout: " << MazeLayout::getName() << std::endl;
+
+    if (isSelected("storage"))
+    {
+        benchmarkStorage(1000);
+        benchmarkStorage(10000);
+
+        benchmarkStorageTypes(10000);
+
+        benchmarkFaceMask(1000);
+        benchmarkFaceMask(10000);
+
+        benchmarkPyramid(10000, 64);
+        benchmarkPyramid(10000, 1000);
+    }
+
+    if (isSelected("layout"))
+    {
+        benchmarkLayout(1000);
+        benchmarkLayout(10000);
+        benchmarkLayout(50000);
+
+        benchmarkGenerator("DFS", new MazeGeneratorDFS(1000, "benchmark"));
+        benchmarkGenerator("DFS", new MazeGeneratorDFS(10000, "benchmark"));
+        benchmarkGenerator("DFS", new MazeGeneratorDFS(50000, "benchmark"));
+    }
+
+    if (std::find(sections.begin(), sections.end(), "huge") != sections.end())
+    {
+        benchmarkGenerator("RD", new MazeGeneratorRD(100000, "benchmark"));
+        benchmarkGenerator("BINARYTREE", new MazeGeneratorBinaryTree(100000, "benchmark"));
+        benchmarkGenerator("SIDEWINDER", new MazeGeneratorSidewinder(100000, "benchmark"));
+    }
+
+    if (isSelected("generators"))
+    {
+        benchmarkGenerator("RD", new MazeGeneratorRD(1000, "benchmark"));
+        benchmarkGenerator("RD", new MazeGeneratorRD(10000, "benchmark"));
+
+        MazeGenerator* wallsGenerator = new MazeGeneratorRD(10000, "benchmark");
+        wallsGenerator->setStorage(MazeGenerator::Storage::WALLS);
+        benchmarkGenerator("RD (WALLS)", wallsGenerator);
+
+        MazeGenerator* chunkedGenerator = new MazeGeneratorRD(10000, "benchmark");
+        chunkedGenerator->setStorage(MazeGenerator::Storage::CHUNKED);
+        benchmarkGenerator("RD (CHUNKED)", chunkedGenerator);
+
+        MazeGenerator* compressedGenerator = new MazeGeneratorRD(10000, "benchmark");
+        compressedGenerator->setStorage(MazeGenerator::Storage::COMPRESSED);
+        benchmarkGenerator("RD (COMPRESSED)", compressedGenerator);
+
+        MazeGenerator* mappedGenerator = new MazeGeneratorRD(10000, "benchmark");
+        mappedGenerator->setMazeFile("glmaze_benchmark.maze");
+        benchmarkGenerator("RD (maze file)", mappedGenerator);
+        std::remove("glmaze_benchmark.maze");
+
+        //Recursive DFS slows down too fast with size to run it on big mazes
+        benchmarkDFS(100);
+        benchmarkDFS(150);
+
+        benchmarkGenerator("DFS", new MazeGeneratorDFS(1000, "benchmark"));
+        benchmarkGenerator("DFS", new MazeGeneratorDFS(10000, "benchmark"));
+
+        benchmarkGenerator("ELLER", new MazeGeneratorEller(1000, "benchmark"));
+        benchmarkGenerator("ELLER", new MazeGeneratorEller(10000, "benchmark"));
+        benchmarkEllerStream(1000, 100000);
+
+        benchmarkGenerator("WILSON", new MazeGeneratorWilson(1000, "benchmark"));
+        benchmarkGenerator("WILSON", new MazeGeneratorWilson(10000, "benchmark"));
+
+        benchmarkGenerator("KRUSKAL", new MazeGeneratorKruskal(1000, "benchmark"));
+        benchmarkGenerator("KRUSKAL", new MazeGeneratorKruskal(10000, "benchmark"));
+
+        benchmarkGenerator("PRIM", new MazeGeneratorPrim(1000, "benchmark"));
+        benchmarkGenerator("PRIM", new MazeGeneratorPrim(10000, "benchmark"));
+
+        benchmarkGenerator("BINARYTREE", new MazeGeneratorBinaryTree(1000, "benchmark"));
+        benchmarkGenerator("BINARYTREE", new MazeGeneratorBinaryTree(10000, "benchmark"));
+
+        benchmarkGenerator("SIDEWINDER", new MazeGeneratorSidewinder(1000, "benchmark"));
+        benchmarkGenerator("SIDEWINDER", new MazeGeneratorSidewinder(10000, "benchmark"));
+
+        benchmarkGenerator("HUNTANDKILL", new MazeGeneratorHuntAndKill(1000, "benchmark"));
+        benchmarkGenerator("HUNTANDKILL", new MazeGeneratorHuntAndKill(10000, "benchmark"));
+
+        benchmarkGenerator("GT:newest", createMazeGeneratorGrowingTree(10000, "benchmark", "newest"));
+        benchmarkGenerator("GT:random", createMazeGeneratorGrowingTree(10000, "benchmark", "random"));
+        benchmarkGenerator("GT:oldest", createMazeGeneratorGrowingTree(10000, "benchmark", "oldest"));
+        benchmarkGenerator("GT:newest=0.75", createMazeGeneratorGrowingTree(1000, "benchmark", "newest=0.75"));
+        benchmarkGenerator("GT:newest=0.75", createMazeGeneratorGrowingTree(10000, "benchmark", "newest=0.75"));
+
+        MazeGenerator* chunkedDFSGenerator = new MazeGeneratorDFS(10000, "benchmark");
+        chunkedDFSGenerator->setStorage(MazeGenerator::Storage::CHUNKED);
+        benchmarkGenerator("DFS (CHUNKED)", chunkedDFSGenerator);
+    }
+
+    if (isSelected("world"))
+    {
+        benchmarkWorld(10000, 1);
+        benchmarkWorld(10000, 3);
+    }
+
+    if (isSelected("sliced"))
+    {
+        benchmarkSliced<MazeGeneratorDFS>("DFS", 2000, 1024);
+        benchmarkSliced<MazeGeneratorDFS>("DFS", 2000, 16384);
+        benchmarkSliced<MazeGeneratorRD>("RD", 10000, 1024);
+        benchmarkSliced<MazeGeneratorRD>("RD", 10000, 16384);
+    }
+
+    if (isSelected("registry"))
+    {
+        benchmarkRegistry(2000);
+    }
+
+    if (isSelected("parallel"))
+    {
+        benchmarkParallel<MazeGeneratorRD>("RD", 10000);
+        benchmarkParallel<MazeGeneratorRD>("RD", 50000);
+
+        benchmarkParallel<MazeGeneratorKruskal>("KRUSKAL", 10000);
+        benchmarkParallel<MazeGeneratorKruskal>("KRUSKAL", 20000); //Sets of all cells need 4 bytes per cell
+
+        benchmarkParallel<MazeGeneratorSidewinder>("SIDEWINDER", 10000);
+        benchmarkParallel<MazeGeneratorSidewinder>("SIDEWINDER", 50000);
+    }
+
+    return 0;
+}
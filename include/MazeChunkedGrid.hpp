@@ -0,0 +1,48 @@
+#ifndef MAZECHUNKEDGRID_HPP
+#define MAZECHUNKEDGRID_HPP
+
+#include "MazeGrid.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//Sparse maze array split into 256x256 chunks
+//Chunk memory is allocated on first write that changes it, until then chunk is stored only as tag (all empty or all walls)
+//Chunks that become uniform again are released by compact()
+class MazeChunkedGrid : public MazeStorage
+{
+    public:
+        MazeChunkedGrid(std::uint64_t size);
+
+        bool get(std::uint64_t row, std::uint64_t column) const
+        {
+            std::size_t chunk = (row >> 8) * chunksPerRow + (column >> 8);
+            const std::uint64_t* data = chunks[chunk].get();
+
+            if (data == nullptr)
+            {
+                return tags[chunk] == Tag::WALL;
+            }
+
+            return (data[(row & 255) * 4 + ((column & 255) >> 6)] >> (column & 63)) & 1;
+        }
+
+        void set(std::uint64_t row, std::uint64_t column, bool value);
+        void fill(bool value);
+        void compact();
+        std::size_t getMemoryUsage() const;
+        std::string getStatistics() const;
+
+        std::size_t getResidentChunks() const;
+        std::size_t getChunkCount() const;
+
+    private:
+        enum Tag : std::uint8_t { EMPTY = 0, WALL = 1 };
+
+        std::vector<std::unique_ptr<std::uint64_t[]>> chunks;
+        std::vector<Tag> tags; //Value of whole chunk when it's not allocated
+        std::size_t chunksPerRow, residentChunks;
+};
+
+#endif
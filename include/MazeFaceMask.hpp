@@ -0,0 +1,67 @@
+#ifndef MAZEFACEMASK_HPP
+#define MAZEFACEMASK_HPP
+
+#include "MazeGrid.hpp"
+#include "MazeWallGrid.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//Visible wall faces of every empty maze field, used by renderer
+//Face is visible when field is empty and its neighbour in that direction is wall
+//After build() masks are read from four precomputed bitplanes, before that (or when maze is too big) they are derived from maze array
+//With WALLS storage masks are derived from wall bits of fields, so render window doesn't go through generic storage reads
+class MazeFaceMask
+{
+    public:
+        enum Face : std::uint8_t { LEFT = 1, RIGHT = 2, FRONT = 4, BACK = 8, EXIT = 16 };
+
+        //Biggest maze for which building masks makes sense (bitplanes need half a byte per field)
+        static const std::uint64_t MAX_BUILD_SIZE = 16384;
+
+        MazeFaceMask(const MazeGridView& mazeArray, std::uint64_t exitRow, std::uint64_t exitColumn, const MazeWallGrid* wallGrid = nullptr);
+
+        //Compute bitplanes for whole maze, rows are split into bands for threads (0 means one thread per CPU core)
+        void build(unsigned int threads = 0);
+
+        std::uint8_t get(std::uint64_t row, std::uint64_t column) const
+        {
+            std::uint8_t mask;
+
+            if (!planes.empty())
+            {
+                const std::uint64_t* words = &planes[(row * stride + (column >> 6)) * 4];
+                unsigned int bit = column & 63;
+
+                mask = ((words[0] >> bit) & 1) | (((words[1] >> bit) & 1) << 1) | (((words[2] >> bit) & 1) << 2) | (((words[3] >> bit) & 1) << 3);
+            }
+            else
+            {
+                mask = deriveMask(row, column);
+            }
+
+            if (row == exitRow && column == exitColumn)
+            {
+                mask |= Face::EXIT;
+            }
+
+            return mask;
+        }
+
+        bool isBuilt() const;
+        std::size_t getMemoryUsage() const;
+
+    private:
+        MazeGridView mazeArray;
+        const MazeWallGrid* wallGrid; //Storage of mazeArray if it's WALLS, nullptr otherwise
+        std::uint64_t size, exitRow, exitColumn;
+        std::size_t stride;
+        std::vector<std::uint64_t> planes; //Left, right, front and back words of every 64 fields next to each other
+
+        std::uint8_t deriveMask(std::uint64_t row, std::uint64_t column) const;
+        std::uint8_t deriveWallMask(std::uint64_t row, std::uint64_t column) const;
+        void readRow(std::int64_t row, std::uint64_t* words) const;
+        void buildRows(std::uint64_t startRow, std::uint64_t endRow);
+};
+
+#endif
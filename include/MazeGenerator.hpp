@@ -1,8 +1,17 @@
 #ifndef MAZEGENERATOR_HPP
 #define MAZEGENERATOR_HPP
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <vector>
 #include <random>
+#include <string>
+
+#include "MazeGrid.hpp"
+#include "MazeRandom.hpp"
+
+class MazeWallGrid;
 
 //Base class for maze generators
 //Defines some common fields, virtual methods and implements some common methods
@@ -10,31 +19,119 @@ class MazeGenerator
 {
     public:
         enum Direction { TOP = 0, BOTTOM = 1, LEFT = 2, RIGHT = 3 };
+        enum Storage { BITS = 0, WALLS = 1, CHUNKED = 2, COMPRESSED = 3 };
 
-        MazeGenerator(unsigned int size, std::string seed = "");
+        MazeGenerator(std::uint64_t size, std::string seed = "");
         virtual ~MazeGenerator();
 
         virtual void generateMaze() = 0;
-        bool** getMazeArray();
+
+        //Resumable generation, every call does at most budget units of work (tried moves, divided chambers) and returns true when generation is finished
+        //Generators without resumable generation generate whole maze in the first call
+        virtual bool step(std::uint64_t budget);
+
+        //Run steps until generation is finished or time runs out (time is checked after every STEP_SLICE units of work)
+        bool stepFor(std::chrono::microseconds time);
+
+        //Called with field of player every frame, generators that generate maze around player (endless maze) use it
+        virtual void updatePosition(std::uint64_t, std::uint64_t) {}
+
+        bool setStorage(Storage storage);
+        void setMazeFile(std::string path);
+        bool setThreads(unsigned int threads);
+        MazeGridView getMazeArray();
         
-        unsigned int getMazeSize();
-        unsigned int getStartX();
-        unsigned int getStartY();
-        unsigned int getEndX();
-        unsigned int getEndY();
+        std::uint64_t getMazeSize();
+        std::uint64_t getStartX();
+        std::uint64_t getStartY();
+        std::uint64_t getEndX();
+        std::uint64_t getEndY();
         Direction getEndBorder();
+        Storage getStorage();
+        const MazeWallGrid* getWallGrid();
+        std::size_t getMemoryUsage();
+        std::string getStorageStatistics();
+        std::size_t getPeakStackSize();
+        void compactArray();
+
+        //Progress of generation from 0 to 1, it can be read from other thread while generateMaze runs
+        double getProgress();
+
+        //Stop generation from other thread, generateMaze returns soon without exit and start position and maze is not complete
+        void cancel();
+        bool isCancelled();
 
     protected:
-        unsigned int mazeSize, startX, startY, endX, endY;
-        bool** mazeArray;
-        bool arrayAllocated;
-        std::mt19937 randomEngine;
+        std::uint64_t mazeSize, startX, startY, endX, endY;
+        MazeGrid mazeArray;
+        bool arrayAllocated, wallStorageSupported, parallelSupported;
+        std::mt19937 randomEngine; //Serial generators use it to keep mazes of existing seeds
+        std::uint64_t seedKey; //Seed as one number, key of counter-based random streams
+        unsigned int threadCount; //0 means serial generation
         Direction endBorder;
+        Storage storageType;
+        std::string mazeFile; //If not empty BITS storage is memory-mapped from this file
+        std::size_t peakStackSize; //Biggest count of entries on generator work stack
+        std::unique_ptr<MazeStorage> storage; //Used instead of mazeArray when storage is not BITS (COMPRESSED uses it after compactArray)
+        std::atomic<std::uint64_t> progressDone, progressTotal; //Units of work are chosen by generator (usually passages carved)
+        std::atomic<bool> cancelRequested;
+
+        //Progress is updated only every PROGRESS_STEP units of work, so atomic operations don't slow down generators
+        static const std::uint64_t PROGRESS_STEP = 4096;
+
+        static const std::uint64_t STEP_SLICE = 1024;
 
-        virtual void allocateArray() = 0;
-        int getRandomNumber(int min, int max);
+        //Resumable generators keep their position between steps, generateMaze starts from the beginning and runs one unlimited step
+        enum StepState { STARTING = 0, RUNNING = 1, FINISHED = 2 };
+        StepState stepState;
+
+        //Generators that write every word of every row can skip clearing of BITS array
+        void allocateArray(bool clearArray = true);
+
+        //Field accessors that work with every storage type
+        bool getField(std::uint64_t row, std::uint64_t column)
+        {
+            if (storage)
+            {
+                return storage->get(row, column);
+            }
+
+            return mazeArray.get(row, column);
+        }
+
+        void setField(std::uint64_t row, std::uint64_t column, bool value)
+        {
+            if (storage)
+            {
+                storage->set(row, column, value);
+            }
+            else
+            {
+                mazeArray.set(row, column, value);
+            }
+        }
+
+        void fillFields(bool value);
+        void fillRowFields(std::uint64_t row, std::uint64_t startColumn, std::uint64_t endColumn, bool value);
+        void fillColumnFields(std::uint64_t column, std::uint64_t startRow, std::uint64_t endRow, bool value);
+
+        std::int64_t getRandomNumber(std::int64_t min, std::int64_t max);
+        MazeRandom getRandomStream(std::uint64_t stream);
         void setStartPosition();
         void setExit();
+
+        void startProgress(std::uint64_t total);
+
+        void setProgress(std::uint64_t done)
+        {
+            progressDone.store(done, std::memory_order_relaxed);
+        }
+
+        //For threads that report their own parts of work
+        void addProgress(std::uint64_t done)
+        {
+            progressDone.fetch_add(done, std::memory_order_relaxed);
+        }
 };
 
 #endif
@@ -0,0 +1,18 @@
+#ifndef MAZEGENERATORBINARYTREE_HPP
+#define MAZEGENERATORBINARYTREE_HPP
+
+#include "MazeGeneratorRows.hpp"
+
+//Maze generator that uses binary tree algorithm
+//Every cell has passage up or left (top row is one corridor and left column too), so one random bit decides cell
+//It's fastest generator, but maze has clear diagonal bias
+class MazeGeneratorBinaryTree : public MazeGeneratorRows
+{
+    public:
+        MazeGeneratorBinaryTree(std::uint64_t size, std::string seed = "");
+
+    protected:
+        void carveRow(std::uint64_t cellRow, MazeSequentialRandom& random, RowWork& work);
+};
+
+#endif
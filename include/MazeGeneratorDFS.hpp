@@ -3,20 +3,28 @@
 
 #include "MazeGenerator.hpp"
 
+#include <cstdint>
 #include <vector>
 
 //Maze generator that uses deep first search algorithm
+//Search is iterative, stack holds one byte per cell on current path (directions left to try and direction cell was entered from)
+//Position and next move are kept between steps, so search can be resumed after any move
 class MazeGeneratorDFS : public MazeGenerator
 {
     private:
-        std::vector<int> directions;
+        enum Move { UP = 0, DOWN = 1, LEFT = 2, RIGHT = 3 };
 
-        void allocateArray();
-        void addPath(unsigned int x, unsigned int y);
+        std::vector<std::uint8_t> pathStack;
+        std::uint64_t pathX, pathY, carvedFields;
+        Move pathMove;
+
+        bool canCarve(std::uint64_t x, std::uint64_t y);
+        bool carvePath(std::uint64_t budget);
 
     public:
-        MazeGeneratorDFS(unsigned int size, std::string seed = "");
+        MazeGeneratorDFS(std::uint64_t size, std::string seed = "");
         void generateMaze();
+        bool step(std::uint64_t budget);
 };
 
 #endif
@@ -0,0 +1,44 @@
+#ifndef MAZEGENERATORELLER_HPP
+#define MAZEGENERATORELLER_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+//Maze generator that uses Eller's algorithm
+//Maze is generated row by row and only set labels of current row are kept, so memory doesn't grow with count of rows
+//Rows are written into maze array, or passed to row sink without allocating array at all
+class MazeGeneratorEller : public MazeGenerator
+{
+    public:
+        //Receives rows in order from first to last, words hold fields of row as bits (bit i of word j is column j * 64 + i, set bit is wall)
+        //Bits after last column are 0, words are valid only during the call
+        typedef std::function<void(std::uint64_t row, const std::uint64_t* words)> RowSink;
+
+        MazeGeneratorEller(std::uint64_t size, std::string seed = "");
+        void generateMaze();
+
+        //Stream rows to sink instead of maze array, it needs to be called before generateMaze
+        //Count of rows can be different from maze size (0 means square maze), it's rounded up to odd number like maze size (at least 3)
+        void setRowSink(RowSink sink, std::uint64_t rows = 0);
+
+    private:
+        RowSink rowSink;
+        std::uint64_t rowCount;
+
+        //State of current row, every vector has one entry per cell
+        std::vector<std::uint32_t> cellSets; //Set label of every cell (no set when cell isn't connected to row above)
+        std::vector<std::uint32_t> setParents; //Union-find over set labels, reset for every row
+        std::vector<std::uint32_t> setCells; //Cells of set not visited yet while choosing down passages
+        std::vector<std::uint64_t> usedStamps; //Label is used in current row if its stamp is row + 1
+        std::vector<std::uint64_t> downStamps; //Set has passage down from current row if its stamp is row + 1
+        std::vector<std::uint64_t> rowWords;
+
+        std::uint32_t findSet(std::uint32_t set);
+        void assignSets(std::uint64_t cellRow);
+        void writeRow(std::uint64_t row);
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef MAZEGENERATORGROWINGTREE_HPP
+#define MAZEGENERATORGROWINGTREE_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Cell selection policies of growing tree, select returns index to list of active cells (0 is oldest cell, size - 1 newest)
+//Newest cell gives DFS-like mazes with long corridors, random cell gives Prim-like mazes with short dead ends
+//keepsOrder is set by policies that choose by age among other choices, so removed cells can't be replaced by newest cell
+struct MazeGrowingTreeNewest
+{
+    static const bool keepsOrder = false;
+
+    std::uint64_t select(MazeSequentialRandom&, std::uint64_t size) const { return size - 1; }
+};
+
+struct MazeGrowingTreeOldest
+{
+    static const bool keepsOrder = false;
+
+    std::uint64_t select(MazeSequentialRandom&, std::uint64_t) const { return 0; }
+};
+
+struct MazeGrowingTreeRandom
+{
+    static const bool keepsOrder = false;
+
+    std::uint64_t select(MazeSequentialRandom& random, std::uint64_t size) const { return random.getBounded32(size); }
+};
+
+//Newest cell with newest probability, oldest cell with oldest probability and random cell otherwise
+//One 64-bit number decides policy (high half) and random index (low half)
+struct MazeGrowingTreeMixed
+{
+    static const bool keepsOrder = true;
+
+    std::uint64_t newestLimit, oldestLimit; //Limits of high half of random number (2^32 is whole range)
+
+    MazeGrowingTreeMixed(double newest = 0.5, double oldest = 0.0);
+
+    std::uint64_t select(MazeSequentialRandom& random, std::uint64_t size) const
+    {
+        std::uint64_t value = random.next();
+        std::uint64_t choice = value >> 32;
+
+        if (choice < newestLimit)
+        {
+            return size - 1;
+        }
+
+        if (choice < oldestLimit)
+        {
+            return 0;
+        }
+
+        return ((value & 0xFFFFFFFF) * size) >> 32;
+    }
+};
+
+//Maze generator that uses growing tree algorithm
+//Active cell chosen by policy carves to random unvisited neighbour, which becomes active, cell without unvisited neighbours is removed
+//Policy is template parameter, so main loop is compiled for every policy without virtual calls
+//Active cells are in ring buffer (capacity is power of two and doubles when it's full), so removing oldest and newest cell is O(1)
+//Other removed cells are replaced by newest cell, or marked as removed and compacted later if policy keeps age order
+template <typename Policy>
+class MazeGeneratorGrowingTree : public MazeGenerator
+{
+    public:
+        MazeGeneratorGrowingTree(std::uint64_t size, std::string seed = "", Policy policy = Policy());
+        void generateMaze();
+
+    private:
+        Policy policy;
+        std::uint64_t cellColumns, cellRows;
+        std::vector<std::uint64_t> activeCells; //Cells as row in high half and column in low half
+        std::uint64_t activeStart, activeCount; //Count includes cells marked as removed
+        std::uint64_t removedCount;
+        static const std::uint64_t REMOVED_CELL = ~std::uint64_t(0);
+
+        std::vector<std::uint64_t> mazeCells; //Bit for every cell that is in maze (WALLS storage keeps cells always open, so it can't be read from grid)
+
+        std::uint64_t& getActive(std::uint64_t index)
+        {
+            return activeCells[(activeStart + index) & (activeCells.size() - 1)];
+        }
+
+        bool isInMaze(std::uint64_t cellRow, std::uint64_t cellColumn) const
+        {
+            std::uint64_t cell = cellRow * cellColumns + cellColumn;
+
+            return (mazeCells[cell >> 6] >> (cell & 63)) & 1;
+        }
+
+        void addCell(std::uint64_t cellRow, std::uint64_t cellColumn);
+        void removeActive(std::uint64_t index);
+};
+
+//Create growing tree generator from policy description like "newest", "random", "oldest" or weights like "newest=0.75" or "newest=0.5,oldest=0.25"
+//Weights that don't add up to 1 are completed by random policy, empty description is "newest"
+//Returns nullptr if description isn't valid
+MazeGenerator* createMazeGeneratorGrowingTree(std::uint64_t size, std::string seed, const std::string& policy);
+
+#endif
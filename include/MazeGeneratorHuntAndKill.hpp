@@ -0,0 +1,34 @@
+#ifndef MAZEGENERATORHUNTANDKILL_HPP
+#define MAZEGENERATORHUNTANDKILL_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//Maze generator that uses hunt-and-kill algorithm
+//Random walk carves through unvisited cells until it's stuck, then hunt finds unvisited cell next to maze and walk continues from it
+//Mazes have long corridors like DFS, but there is no stack, only visited bit of every cell (rows are padded to whole words)
+//Hunt checks 64 cells at once with bit operations and starts at first word that has unvisited cells
+class MazeGeneratorHuntAndKill : public MazeGenerator
+{
+    public:
+        MazeGeneratorHuntAndKill(std::uint64_t size, std::string seed = "");
+        void generateMaze();
+
+    private:
+        std::uint64_t cellColumns, cellRows;
+        std::uint64_t rowWords; //Words of visited bits in one row of cells
+        std::uint64_t huntWord; //All words of visited bits before it are full
+        std::vector<std::uint64_t> visitedCells;
+
+        bool isVisited(std::uint64_t cellRow, std::uint64_t cellColumn) const
+        {
+            return (visitedCells[cellRow * rowWords + (cellColumn >> 6)] >> (cellColumn & 63)) & 1;
+        }
+
+        void visit(std::uint64_t cellRow, std::uint64_t cellColumn);
+        bool hunt(std::uint64_t& cellRow, std::uint64_t& cellColumn);
+};
+
+#endif
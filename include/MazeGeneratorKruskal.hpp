@@ -0,0 +1,45 @@
+#ifndef MAZEGENERATORKRUSKAL_HPP
+#define MAZEGENERATORKRUSKAL_HPP
+
+#include "MazeGenerator.hpp"
+#include "MazeUnionFind.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//Maze generator that uses randomized Kruskal's algorithm
+//Serial generation shuffles all interior walls and removes every wall that joins two different sets of cells (flat union-find)
+//Parallel generation splits cells into square tiles (Filter-Kruskal style): every tile merges first half of its shuffled walls with cell sets
+//that stay inside of tile and filters out rest of walls that already join one set, then walls between tiles and remaining walls
+//are shuffled and merged with the same cell sets, so cells are joined across tile borders as often as inside of tiles
+//Tiles have own random streams, so maze of parallel generation doesn't depend on count of threads (it's different from serial one)
+class MazeGeneratorKruskal : public MazeGenerator
+{
+    public:
+        MazeGeneratorKruskal(std::uint64_t size, std::string seed = "");
+        void generateMaze();
+
+    private:
+        //Side of tile in cells, tile fields start right after word boundary, so tiles never write the same word
+        static const std::uint64_t TILE_CELLS = 256;
+
+        //Work buffers of one thread
+        struct TileWork
+        {
+            std::vector<std::uint32_t> walls;
+            std::vector<std::uint64_t> fields; //Fields of tile as bits, row by row
+        };
+
+        std::uint64_t cellColumns, cellRows, tileColumns, tileRows;
+        MazeUnionFind cells; //Sets of all cells, tiles use only their own cells, so they can change it at the same time
+
+        void generateSerial();
+        void generateParallel();
+        void mergeTile(std::uint64_t tile, TileWork& work, std::vector<std::uint64_t>& remainingWalls);
+        void mergeTiles(std::vector<std::vector<std::uint64_t>>& tileWalls);
+
+        //Remove wall (cell index * 2 for wall right of cell, cell index * 2 + 1 for wall below cell) if it joins two sets
+        bool mergeWall(std::uint64_t wall);
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef MAZEGENERATORPRIM_HPP
+#define MAZEGENERATORPRIM_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//Maze generator that uses randomized Prim's algorithm
+//Maze grows from one cell, random cell of frontier (cells next to maze) is joined to random maze neighbour
+//Frontier is flat array with swap-remove and cells have in-frontier and in-maze bits, so there are no node-based containers
+class MazeGeneratorPrim : public MazeGenerator
+{
+    public:
+        MazeGeneratorPrim(std::uint64_t size, std::string seed = "");
+        void generateMaze();
+
+    private:
+        std::uint64_t cellColumns, cellRows;
+        std::vector<std::uint64_t> frontier; //Cells as row in high half and column in low half, so they don't need division
+        std::vector<std::uint64_t> frontierCells; //Bit for every cell that is in frontier
+        std::vector<std::uint64_t> mazeCells; //Bit for every cell that is in maze (WALLS storage keeps cells always open, so it can't be read from grid)
+
+        bool isInMaze(std::uint64_t cellRow, std::uint64_t cellColumn)
+        {
+            std::uint64_t cell = cellRow * cellColumns + cellColumn;
+
+            return (mazeCells[cell >> 6] >> (cell & 63)) & 1;
+        }
+
+        void addToMaze(std::uint64_t cellRow, std::uint64_t cellColumn);
+        void addToFrontier(std::uint64_t cellRow, std::uint64_t cellColumn);
+};
+
+#endif
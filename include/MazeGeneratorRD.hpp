@@ -3,20 +3,60 @@
 
 #include "MazeGenerator.hpp"
 
+#include <cstdint>
+#include <vector>
+
 //Maze generator that uses recursive division algorithm
+//Division is iterative, chambers wait on explicit work stack in the same order as recursion would visit them
+//With threads set, big chambers are divided in parallel by work-stealing task pool
+//Serial division can be resumed, work stack stays between steps
+//Walls of different chambers never share fields, so serial division buffers long vertical walls and writes them in row-major blocks
 class MazeGeneratorRD : public MazeGenerator
 {
     public:
-        MazeGeneratorRD(unsigned int size, std::string seed = "");
+        MazeGeneratorRD(std::uint64_t size, std::string seed = "");
         void generateMaze();
+        bool step(std::uint64_t budget);
 
     private:
         enum Orientation { VERTICAL = 0, HORIZONTAL = 1 };
 
-        void allocateArray();
+        //Chamber waiting on work stack, width used for its orientation is stored separately
+        //(second chamber of vertical division takes orientation from width of the first one)
+        struct Chamber
+        {
+            std::int64_t startFieldX, startFieldY, endFieldX, endFieldY;
+            std::int64_t orientationWidth;
+        };
+
+        //Chamber of parallel division, key is its random stream (derived from stream of parent and index of chamber)
+        struct ParallelChamber
+        {
+            std::int64_t startFieldX, startFieldY, endFieldX, endFieldY;
+            std::uint64_t key;
+        };
+
+        //Chambers with more maze fields are given to task pool, smaller ones are divided by the same thread
+        static const std::int64_t PARALLEL_CHAMBER_FIELDS = 16384;
+
+        //Vertical wall of serial division waiting to be written, passage row is left open
+        struct VerticalWall
+        {
+            std::uint64_t column, startRow, endRow, passageRow;
+        };
+
+        //Vertical walls longer than band are collected and written band by band, so long wall doesn't walk whole array column at once
+        static const std::size_t VERTICAL_WALL_BUFFER = 4096;
+        static const std::uint64_t WALL_BAND_ROWS = 64;
+
+        std::vector<Chamber> chamberStack;
+        std::vector<VerticalWall> verticalWalls, activeWalls;
+        std::uint64_t divisionCount, finishedCellCount; //Divided chambers and cells of chambers that can't be divided
 
-        void divideChamber(int startFieldX, int startFieldY, int endFieldX, int endFieldY, Orientation direction);
-        Orientation setOrientation(int startFieldX, int startFieldY, int endFieldX, int endFieldY);
+        bool divideChambers(std::uint64_t budget);
+        void divideChambersParallel(std::int64_t mazeFields);
+        void flushVerticalWalls();
+        Orientation setOrientation(std::int64_t chamberWidth, std::int64_t chamberHeight);
 };
 
 #endif
@@ -0,0 +1,83 @@
+#ifndef MAZEGENERATORREGISTRY_HPP
+#define MAZEGENERATORREGISTRY_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+//Description of generator, generators register it from their own source file with MazeGeneratorRegistrar
+struct MazeGeneratorInfo
+{
+    enum Capability
+    {
+        PARALLEL = 1, //Can be generated by more threads (setThreads)
+        WALL_STORAGE = 2, //Works with WALLS storage
+        RESUMABLE = 4, //Can be generated in steps (step)
+        STREAMING = 8, //Can pass rows to callback instead of storing maze
+        ENDLESS = 16, //Generates chunks around player, maze size and storage are ignored
+        BIASED = 32 //Mazes have visible bias (for example one corridor along border), AUTO doesn't choose it
+    };
+
+    //Creates generator, parameters are text after colon in generator name (empty if there is none), returns nullptr if they are not valid
+    typedef std::function<MazeGenerator*(std::uint64_t size, const std::string& seed, const std::string& parameters)> Factory;
+
+    std::string name; //Name used by -generator argument and config file
+    std::string description;
+    std::string parameters; //Description of accepted parameters, empty if generator doesn't take any
+    unsigned int capabilities;
+    double megaFieldsPerSecond; //Millions of fields generated per second by one thread with BITS storage (measured by registry section of benchmark)
+    double megaFieldsPerSecondWalls; //The same with WALLS storage (field writes are translated to wall bits), 0 without WALL_STORAGE
+    double bytesPerField; //Memory used while generating besides maze array (stacks, visited bits)
+    Factory create;
+
+    bool hasCapability(Capability capability) const
+    {
+        return (capabilities & capability) != 0;
+    }
+
+    //Estimated peak memory of generation in bytes (maze array of selected storage and generator data)
+    std::uint64_t estimateMemory(std::uint64_t size, MazeGenerator::Storage storage) const;
+};
+
+//List of all generators, it's filled before main by registrars in generator source files
+class MazeGeneratorRegistry
+{
+    public:
+        static MazeGeneratorRegistry& getInstance();
+
+        //Returns false if generator with the same name is already registered
+        bool add(const MazeGeneratorInfo& info);
+
+        //Find generator by name (without parameters), returns nullptr if there is none
+        const MazeGeneratorInfo* find(const std::string& name) const;
+
+        //Generators sorted by name
+        const std::vector<MazeGeneratorInfo>& getGenerators() const;
+
+        //Create generator from name with optional parameters after colon (for example "GT:newest=0.75")
+        //Returns nullptr if generator doesn't exist or its parameters are not valid
+        MazeGenerator* create(const std::string& generator, std::uint64_t size, const std::string& seed) const;
+
+        //Select fastest unbiased generator and storage that fit into memory budget (0 means unlimited), threads are counted only for parallel generators
+        //If nothing fits, generator and storage with the smallest memory estimate are returned
+        const MazeGeneratorInfo* selectFastest(std::uint64_t size, std::uint64_t memoryBudget, unsigned int threads, MazeGenerator::Storage& storage) const;
+
+        //Split "NAME:parameters" to name and parameters
+        static void splitName(const std::string& generator, std::string& name, std::string& parameters);
+
+    private:
+        std::vector<MazeGeneratorInfo> generators;
+};
+
+//Static instance of registrar in generator source file adds generator to registry
+class MazeGeneratorRegistrar
+{
+    public:
+        MazeGeneratorRegistrar(const std::string& name, const std::string& description, const std::string& parameters, unsigned int capabilities,
+                               double megaFieldsPerSecond, double megaFieldsPerSecondWalls, double bytesPerField, MazeGeneratorInfo::Factory create);
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef MAZEGENERATORROWS_HPP
+#define MAZEGENERATORROWS_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//Base class for generators that decide every row of cells only from random bits of that row (binary tree, sidewinder)
+//Every row has own random stream, so rows are carved in bands by more threads and maze doesn't depend on count of threads
+//Word of fields has 32 cells (cell i of word is field 2 * i + 1), so cell bits are spread to whole words of fields at once
+class MazeGeneratorRows : public MazeGenerator
+{
+    public:
+        MazeGeneratorRows(std::uint64_t size, std::string seed = "");
+        void generateMaze();
+
+    protected:
+        //Buffers of one row of cells, all vectors have one entry per word of fields
+        struct RowWork
+        {
+            std::vector<std::uint32_t> cellBits; //One bit per cell, set bit means wall left of cell
+            std::vector<std::uint32_t> upBits; //One bit per cell, set bit means passage up
+            std::vector<std::uint64_t> wallWords; //Fields of row above cells
+            std::vector<std::uint64_t> cellWords; //Fields of row with cells
+        };
+
+        std::uint64_t cellColumns, cellRows;
+
+        //Fill both rows of fields for row of cells, fields after last column don't need to be set
+        virtual void carveRow(std::uint64_t cellRow, MazeSequentialRandom& random, RowWork& work) = 0;
+
+        //Fill cell bits with random bits (or zeros without random), bit of first cell and bits after last cell are always set
+        void fillCellBits(RowWork& work, MazeSequentialRandom* random);
+
+        //Wall bits to fields of row with cells (bit i to field 2 * i, cells are open)
+        //Passage bits to fields of row above cells (bit i clears field 2 * i + 1, rest are walls)
+        static void spreadBits(const std::uint32_t* bits, std::uint64_t* words, std::size_t count, bool passages);
+
+    private:
+        //Rows of fields in one band, bands start at multiple of 64 so they never share word in any layout
+        static const std::uint64_t BAND_ROWS = 64;
+
+        void carveBand(std::uint64_t band, RowWork& work);
+        void writeRow(std::uint64_t row, std::vector<std::uint64_t>& words);
+};
+
+#endif
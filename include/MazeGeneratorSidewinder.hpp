@@ -0,0 +1,18 @@
+#ifndef MAZEGENERATORSIDEWINDER_HPP
+#define MAZEGENERATORSIDEWINDER_HPP
+
+#include "MazeGeneratorRows.hpp"
+
+//Maze generator that uses sidewinder algorithm
+//Row of cells is split into random runs of cells joined left to right and every run has one passage up from one of its cells
+//Top row is one corridor, so maze has long horizontal passages but no diagonal bias of binary tree
+class MazeGeneratorSidewinder : public MazeGeneratorRows
+{
+    public:
+        MazeGeneratorSidewinder(std::uint64_t size, std::string seed = "");
+
+    protected:
+        void carveRow(std::uint64_t cellRow, MazeSequentialRandom& random, RowWork& work);
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef MAZEGENERATORWILSON_HPP
+#define MAZEGENERATORWILSON_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//Maze generator that uses Wilson's algorithm (loop-erased random walks)
+//Every spanning tree of cell grid has the same probability, so mazes are not biased like DFS (long corridors) or RD (blocks)
+//Walk is not stored as path, every cell keeps only direction it was left in (2 bits), so loops are erased by overwriting directions
+class MazeGeneratorWilson : public MazeGenerator
+{
+    public:
+        MazeGeneratorWilson(std::uint64_t size, std::string seed = "");
+        void generateMaze();
+
+    private:
+        enum Move { UP = 0, DOWN = 1, LEFT = 2, RIGHT = 3 };
+
+        std::uint64_t cellColumns, cellRows;
+        std::vector<std::uint64_t> treeCells; //Bit for every cell that is already in maze
+        std::vector<std::uint8_t> cellMoves; //Last move of walk from every cell, 4 cells per byte
+
+        bool isInTree(std::uint64_t cell) const
+        {
+            return (treeCells[cell >> 6] >> (cell & 63)) & 1;
+        }
+
+        Move getMove(std::uint64_t cell) const
+        {
+            return Move((cellMoves[cell >> 2] >> ((cell & 3) * 2)) & 3);
+        }
+
+        void setMove(std::uint64_t cell, Move move)
+        {
+            std::uint8_t& moves = cellMoves[cell >> 2];
+            moves = (moves & ~(3 << ((cell & 3) * 2))) | (move << ((cell & 3) * 2));
+        }
+
+        std::uint64_t findFreeCell(std::uint64_t cell) const;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef MAZEGENERATORWORLD_HPP
+#define MAZEGENERATORWORLD_HPP
+
+#include "MazeGenerator.hpp"
+#include "MazeWorld.hpp"
+
+#include <cstdint>
+
+//Generator of endless maze, it doesn't generate whole maze but MazeWorld storage that generates chunks around player
+//Maze has size of whole world, start is in its middle and there is no exit, updatePosition needs to be called when player moves
+class MazeGeneratorWorld : public MazeGenerator
+{
+    public:
+        MazeGeneratorWorld(std::string seed = "", std::uint64_t radius = 1);
+        void generateMaze();
+
+        //Make chunks around field resident, fields outside of them are walls
+        void updatePosition(std::uint64_t row, std::uint64_t column);
+
+    private:
+        std::uint64_t radius;
+        MazeWorld* world; //Owned by storage
+};
+
+#endif
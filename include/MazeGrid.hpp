@@ -0,0 +1,466 @@
+#ifndef MAZEGRID_HPP
+#define MAZEGRID_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MazeMappedFile.hpp"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+//Set or clear bits of word selected by mask
+//Atomic update is used when more threads write fields that share words (parallel generators)
+inline void updateMazeWord(std::uint64_t& word, std::uint64_t mask, bool value, bool atomic)
+{
+    if (!atomic)
+    {
+        word = value ? (word | mask) : (word & ~mask);
+    }
+    else if (value)
+    {
+        #if defined(_MSC_VER)
+            _InterlockedOr64(reinterpret_cast<volatile long long*>(&word), mask);
+        #else
+            __atomic_fetch_or(&word, mask, __ATOMIC_RELAXED);
+        #endif
+    }
+    else
+    {
+        #if defined(_MSC_VER)
+            _InterlockedAnd64(reinterpret_cast<volatile long long*>(&word), ~mask);
+        #else
+            __atomic_fetch_and(&word, ~mask, __ATOMIC_RELAXED);
+        #endif
+    }
+}
+
+//Layout policies for bit-packed maze array
+//They map field (row, column) to word index and bit index inside that word
+//Stride is count of words in one row of words (row-major) or count of tiles in one row of tiles (tiled layouts)
+//getRowBits returns 64 fields of one row starting at column aligned to 64 (bit i is field column + i)
+//setRowBits sets or clears fields of such 64 field group selected by mask (atomically if requested)
+
+//Row by row, every row is padded to whole 64-bit words so rows never share a word
+struct MazeLayoutRowMajor
+{
+    static const char* getName() { return "row-major"; }
+
+    static std::size_t getStride(std::uint64_t columns)
+    {
+        return (columns + 63) / 64;
+    }
+
+    static std::size_t getWordCount(std::uint64_t rows, std::uint64_t columns)
+    {
+        return getStride(columns) * rows;
+    }
+
+    static std::size_t getWordIndex(std::uint64_t row, std::uint64_t column, std::size_t stride)
+    {
+        return row * stride + (column >> 6);
+    }
+
+    static unsigned int getBitIndex(std::uint64_t, std::uint64_t column)
+    {
+        return column & 63;
+    }
+
+    static std::uint64_t getRowBits(const std::uint64_t* words, std::uint64_t row, std::uint64_t column, std::size_t stride)
+    {
+        return words[getWordIndex(row, column, stride)];
+    }
+
+    static void setRowBits(std::uint64_t* words, std::uint64_t row, std::uint64_t column, std::size_t stride, std::uint64_t mask, bool value, bool atomic)
+    {
+        updateMazeWord(words[getWordIndex(row, column, stride)], mask, value, atomic);
+    }
+};
+
+//64x64 tiles stored one after another, tile is 64 words and every word is one row of tile
+//Moving to neighbour row stays in the same 512 byte tile instead of jumping over whole maze row
+struct MazeLayoutTiled
+{
+    static const char* getName() { return "tiled 64x64"; }
+
+    static std::size_t getStride(std::uint64_t columns)
+    {
+        return (columns + 63) / 64;
+    }
+
+    static std::size_t getWordCount(std::uint64_t rows, std::uint64_t columns)
+    {
+        return getStride(columns) * ((rows + 63) / 64) * 64;
+    }
+
+    static std::size_t getWordIndex(std::uint64_t row, std::uint64_t column, std::size_t stride)
+    {
+        return ((row >> 6) * stride + (column >> 6)) * 64 + (row & 63);
+    }
+
+    static unsigned int getBitIndex(std::uint64_t, std::uint64_t column)
+    {
+        return column & 63;
+    }
+
+    static std::uint64_t getRowBits(const std::uint64_t* words, std::uint64_t row, std::uint64_t column, std::size_t stride)
+    {
+        return words[getWordIndex(row, column, stride)];
+    }
+
+    static void setRowBits(std::uint64_t* words, std::uint64_t row, std::uint64_t column, std::size_t stride, std::uint64_t mask, bool value, bool atomic)
+    {
+        updateMazeWord(words[getWordIndex(row, column, stride)], mask, value, atomic);
+    }
+};
+
+//64x64 tiles like in tiled layout, but every word holds 8x8 block of fields
+//Blocks inside tile are stored in Morton (Z) order so nearby fields in both directions share words and cache lines
+struct MazeLayoutMorton
+{
+    static const char* getName() { return "morton"; }
+
+    static std::size_t getStride(std::uint64_t columns)
+    {
+        return (columns + 63) / 64;
+    }
+
+    static std::size_t getWordCount(std::uint64_t rows, std::uint64_t columns)
+    {
+        return getStride(columns) * ((rows + 63) / 64) * 64;
+    }
+
+    static std::size_t getWordIndex(std::uint64_t row, std::uint64_t column, std::size_t stride)
+    {
+        //Interleave 3 bits of block column (even bits) and block row (odd bits)
+        unsigned int blockColumn = (column >> 3) & 7;
+        unsigned int blockRow = (row >> 3) & 7;
+        unsigned int morton = (blockColumn & 1) | ((blockRow & 1) << 1) | ((blockColumn & 2) << 1) |
+                              ((blockRow & 2) << 2) | ((blockColumn & 4) << 2) | ((blockRow & 4) << 3);
+
+        return ((row >> 6) * stride + (column >> 6)) * 64 + morton;
+    }
+
+    static unsigned int getBitIndex(std::uint64_t row, std::uint64_t column)
+    {
+        return ((row & 7) << 3) | (column & 7);
+    }
+
+    //Row of 8x8 block is one byte of block word, so 64 fields are gathered from 8 blocks
+    static std::uint64_t getRowBits(const std::uint64_t* words, std::uint64_t row, std::uint64_t column, std::size_t stride)
+    {
+        std::uint64_t bits = 0;
+
+        for (unsigned int block = 0; block < 8; block++)
+        {
+            std::uint64_t word = words[getWordIndex(row, column + block * 8, stride)];
+            bits |= ((word >> ((row & 7) * 8)) & 0xFF) << (block * 8);
+        }
+
+        return bits;
+    }
+
+    static void setRowBits(std::uint64_t* words, std::uint64_t row, std::uint64_t column, std::size_t stride, std::uint64_t mask, bool value, bool atomic)
+    {
+        for (unsigned int block = 0; block < 8; block++)
+        {
+            std::uint64_t blockMask = ((mask >> (block * 8)) & 0xFF) << ((row & 7) * 8);
+
+            if (blockMask != 0)
+            {
+                updateMazeWord(words[getWordIndex(row, column + block * 8, stride)], blockMask, value, atomic);
+            }
+        }
+    }
+};
+
+//Layout used by generators and renderer is selected at compile time (GLMAZE_GRID_LAYOUT CMake option)
+#if defined(GLMAZE_GRID_LAYOUT_TILED)
+    typedef MazeLayoutTiled MazeLayout;
+#elif defined(GLMAZE_GRID_LAYOUT_MORTON)
+    typedef MazeLayoutMorton MazeLayout;
+#else
+    typedef MazeLayoutRowMajor MazeLayout;
+#endif
+
+//Interface for maze arrays that don't keep fields as plain bits (for example walls stored on edges)
+//They are accessed with the same field coordinates as MazeGrid
+class MazeStorage
+{
+    public:
+        virtual ~MazeStorage() {}
+
+        virtual bool get(std::uint64_t row, std::uint64_t column) const = 0;
+        virtual void set(std::uint64_t row, std::uint64_t column, bool value) = 0;
+        virtual void fill(bool value) = 0;
+        virtual std::size_t getMemoryUsage() const = 0;
+
+        //Release memory that is not needed after generation
+        virtual void compact() {}
+
+        //Storage specific statistics for diagnostics
+        virtual std::string getStatistics() const { return ""; }
+};
+
+//Non-owning read only view of maze array
+//Fields are stored in one contiguous block of words, placement of fields is defined by layout policy
+//View can also point to MazeStorage, then every read goes through it
+template <typename Layout>
+class BasicMazeGridView
+{
+    public:
+        BasicMazeGridView()
+        {
+            words = nullptr;
+            storage = nullptr;
+            stride = 0;
+            rows = 0;
+            columns = 0;
+        }
+
+        BasicMazeGridView(const std::uint64_t* words, std::size_t stride, std::uint64_t rows, std::uint64_t columns)
+        {
+            this->words = words;
+            this->storage = nullptr;
+            this->stride = stride;
+            this->rows = rows;
+            this->columns = columns;
+        }
+
+        BasicMazeGridView(const MazeStorage* storage, std::uint64_t rows, std::uint64_t columns)
+        {
+            this->words = nullptr;
+            this->storage = storage;
+            this->stride = 0;
+            this->rows = rows;
+            this->columns = columns;
+        }
+
+        bool get(std::uint64_t row, std::uint64_t column) const
+        {
+            if (storage != nullptr)
+            {
+                return storage->get(row, column);
+            }
+
+            return (words[Layout::getWordIndex(row, column, stride)] >> Layout::getBitIndex(row, column)) & 1;
+        }
+
+        //Get 64 fields of row starting at column (column must be multiple of 64), fields outside of array are 0
+        std::uint64_t getBits(std::uint64_t row, std::uint64_t column) const
+        {
+            std::uint64_t bits = 0;
+
+            if (storage != nullptr)
+            {
+                for (std::uint64_t i = 0; i < 64 && column + i < columns; i++)
+                {
+                    bits |= std::uint64_t(storage->get(row, column + i)) << i;
+                }
+
+                return bits;
+            }
+
+            bits = Layout::getRowBits(words, row, column, stride);
+
+            if (columns - column < 64)
+            {
+                bits &= (std::uint64_t(1) << (columns - column)) - 1;
+            }
+
+            return bits;
+        }
+
+        std::size_t getStride() const { return stride; }
+        std::uint64_t getRows() const { return rows; }
+        std::uint64_t getColumns() const { return columns; }
+
+    private:
+        const std::uint64_t* words;
+        const MazeStorage* storage;
+        std::size_t stride;
+        std::uint64_t rows, columns;
+};
+
+//Bit-packed maze array, one bit per field (set bit means wall)
+//Whole array is one block of words, either allocated on heap or mapped from file
+//Placement of fields is defined by layout policy
+template <typename Layout>
+class BasicMazeGrid
+{
+    public:
+        BasicMazeGrid()
+        {
+            words = nullptr;
+            wordCount = 0;
+            rows = 0;
+            columns = 0;
+            stride = 0;
+        }
+
+        BasicMazeGrid(const BasicMazeGrid&) = delete;
+        BasicMazeGrid& operator=(const BasicMazeGrid&) = delete;
+
+        //Allocate grid for given size on heap, all fields are cleared (empty)
+        //Without clear fields are left uninitialized, caller has to write every word of every row (for example with setBits)
+        void allocate(std::uint64_t rowCount, std::uint64_t columnCount, bool clear = true)
+        {
+            mappedFile.close();
+            heapWords.reset();
+
+            setSize(rowCount, columnCount);
+
+            heapWords.reset(new std::uint64_t[wordCount]);
+            words = heapWords.get();
+
+            //Padding rows of last row of tiles are never written by rows, so they are cleared too
+            if (clear || wordCount != rows * stride)
+            {
+                fill(false);
+            }
+        }
+
+        //Allocate grid in memory-mapped file, file is created or resized to needed size
+        //Fields keep values that were in file before, returns false if file can't be mapped
+        bool allocateMapped(std::uint64_t rowCount, std::uint64_t columnCount, const std::string& path)
+        {
+            if (!mappedFile.open(path, Layout::getWordCount(rowCount, columnCount) * sizeof(std::uint64_t)))
+            {
+                return false;
+            }
+
+            heapWords.reset();
+
+            setSize(rowCount, columnCount);
+
+            words = static_cast<std::uint64_t*>(mappedFile.getData());
+
+            return true;
+        }
+
+        //Set all fields to the same value with single bulk fill (padding bits are filled too, they are never read)
+        void fill(bool value)
+        {
+            std::fill(words, words + wordCount, value ? ~std::uint64_t(0) : std::uint64_t(0));
+        }
+
+        BasicMazeGridView<Layout> getView() const
+        {
+            return BasicMazeGridView<Layout>(words, stride, rows, columns);
+        }
+
+        //Field accessors, these are used in hot loops so they are defined here to allow inlining
+        bool get(std::uint64_t row, std::uint64_t column) const
+        {
+            return (words[Layout::getWordIndex(row, column, stride)] >> Layout::getBitIndex(row, column)) & 1;
+        }
+
+        void set(std::uint64_t row, std::uint64_t column, bool value)
+        {
+            std::uint64_t& word = words[Layout::getWordIndex(row, column, stride)];
+            std::uint64_t mask = std::uint64_t(1) << Layout::getBitIndex(row, column);
+
+            word = (word & ~mask) | ((std::uint64_t(0) - std::uint64_t(value)) & mask);
+        }
+
+        //Set field with atomic operation, other threads can write fields in the same word at the same time
+        void setAtomic(std::uint64_t row, std::uint64_t column, bool value)
+        {
+            updateMazeWord(words[Layout::getWordIndex(row, column, stride)], std::uint64_t(1) << Layout::getBitIndex(row, column), value, true);
+        }
+
+        //Set fields [startColumn, endColumn) of row, up to 64 fields are written at once
+        void fillRow(std::uint64_t row, std::uint64_t startColumn, std::uint64_t endColumn, bool value, bool atomic = false)
+        {
+            for (std::uint64_t column = startColumn & ~std::uint64_t(63); column < endColumn; column += 64)
+            {
+                std::uint64_t mask = ~std::uint64_t(0);
+
+                if (column < startColumn)
+                {
+                    mask <<= startColumn - column;
+                }
+
+                if (endColumn - column < 64)
+                {
+                    mask &= (std::uint64_t(1) << (endColumn - column)) - 1;
+                }
+
+                Layout::setRowBits(words, row, column, stride, mask, value, atomic);
+            }
+        }
+
+        //Set 64 fields of row starting at column (column must be multiple of 64) from bits, bit i is field column + i
+        void setBits(std::uint64_t row, std::uint64_t column, std::uint64_t bits)
+        {
+            Layout::setRowBits(words, row, column, stride, bits, true, false);
+            Layout::setRowBits(words, row, column, stride, ~bits, false, false);
+        }
+
+        //Set fields [startRow, endRow) of column
+        void fillColumn(std::uint64_t column, std::uint64_t startRow, std::uint64_t endRow, bool value, bool atomic = false)
+        {
+            for (std::uint64_t row = startRow; row < endRow; row++)
+            {
+                if (atomic)
+                {
+                    setAtomic(row, column, value);
+                }
+                else
+                {
+                    set(row, column, value);
+                }
+            }
+        }
+
+        std::uint64_t getRows() const { return rows; }
+        std::uint64_t getColumns() const { return columns; }
+
+        bool isMapped() const { return mappedFile.getData() != nullptr; }
+
+        //Free array memory (or unmap file), grid needs to be allocated again before next use
+        void release()
+        {
+            mappedFile.close();
+
+            heapWords.reset();
+
+            words = nullptr;
+            wordCount = 0;
+            rows = 0;
+            columns = 0;
+            stride = 0;
+        }
+
+        //Get size of field data in bytes (for mapped grid only part of it is resident in memory)
+        std::size_t getMemoryUsage() const
+        {
+            return wordCount * sizeof(std::uint64_t);
+        }
+
+    private:
+        std::uint64_t* words;
+        std::size_t wordCount;
+        std::unique_ptr<std::uint64_t[]> heapWords;
+        MazeMappedFile mappedFile;
+        std::uint64_t rows, columns;
+        std::size_t stride;
+
+        void setSize(std::uint64_t rowCount, std::uint64_t columnCount)
+        {
+            rows = rowCount;
+            columns = columnCount;
+            stride = Layout::getStride(columns);
+            wordCount = Layout::getWordCount(rows, columns);
+        }
+};
+
+typedef BasicMazeGridView<MazeLayout> MazeGridView;
+typedef BasicMazeGrid<MazeLayout> MazeGrid;
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef MAZEMAPPEDFILE_HPP
+#define MAZEMAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+//File mapped into memory, used as backing storage for maze array
+//Operating system loads and evicts pages on demand so mapped maze can be bigger than physical memory
+class MazeMappedFile
+{
+    public:
+        MazeMappedFile();
+        ~MazeMappedFile();
+
+        MazeMappedFile(const MazeMappedFile&) = delete;
+        MazeMappedFile& operator=(const MazeMappedFile&) = delete;
+
+        bool open(const std::string& path, std::size_t size);
+        void close();
+
+        void* getData() const;
+        std::size_t getSize() const;
+
+    private:
+        void* data;
+        std::size_t size;
+
+        #if defined(WIN32) || defined(_WIN32)
+            void* fileHandle;
+            void* mappingHandle;
+        #else
+            int fileDescriptor;
+        #endif
+};
+
+#endif
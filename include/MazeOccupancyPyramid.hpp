@@ -0,0 +1,51 @@
+#ifndef MAZEOCCUPANCYPYRAMID_HPP
+#define MAZEOCCUPANCYPYRAMID_HPP
+
+#include "MazeGrid.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//Counts of walls in square blocks of maze, every level halves resolution of previous one
+//Level 0 has 8x8 field blocks, level 1 16x16 blocks and so on until whole maze is one block
+//Used for coarse queries on big mazes (overview rendering, culling, sampling) without scanning maze array
+class MazeOccupancyPyramid
+{
+    public:
+        MazeOccupancyPyramid(const MazeGridView& mazeArray);
+
+        //Count walls in all blocks, needs to be called after maze is generated
+        void build();
+
+        //Field in maze array was changed, recount its block and update levels above it
+        void update(std::uint64_t row, std::uint64_t column);
+
+        //Queries for rectangle of fields [startRow, endRow) x [startColumn, endColumn)
+        std::uint64_t countWalls(std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const;
+        bool anyOpen(std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const;
+        bool allWalls(std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const;
+
+        unsigned int getLevelCount() const;
+        std::uint64_t getBlockSize(unsigned int level) const;
+        std::uint64_t getBlocksPerRow(unsigned int level) const;
+        std::uint64_t getWalls(unsigned int level, std::uint64_t blockRow, std::uint64_t blockColumn) const;
+        std::size_t getMemoryUsage() const;
+
+    private:
+        MazeGridView mazeArray;
+        std::uint64_t size;
+
+        //Counts are stored in smallest type that can hold them
+        std::vector<std::uint8_t> baseLevel; //8x8 blocks, at most 64 walls
+        std::vector<std::uint16_t> secondLevel; //16x16 blocks, at most 256 walls
+        std::vector<std::vector<std::uint64_t>> upperLevels; //Levels 2 and above
+        std::vector<std::uint64_t> blocksPerRow;
+
+        void addWalls(unsigned int level, std::uint64_t blockRow, std::uint64_t blockColumn, std::int64_t walls);
+        std::uint8_t countBlock(std::uint64_t blockRow, std::uint64_t blockColumn) const;
+        std::uint64_t countFields(std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const;
+        std::uint64_t countRegion(unsigned int level, std::uint64_t blockRow, std::uint64_t blockColumn,
+                                  std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const;
+};
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef MAZERANDOM_HPP
+#define MAZERANDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+//Counter-based random numbers (Philox4x32-10)
+//Every number is a pure function of (seed, stream, counter), so generators can draw numbers for chambers, tiles or rows in any order
+//and get the same maze on every platform and with any count of threads
+//Bounded numbers use Lemire's multiply-shift method, so they don't depend on standard library distributions
+class MazeRandom
+{
+    public:
+        MazeRandom(std::uint64_t seed = 0, std::uint64_t stream = 0);
+
+        //Random 64-bit number at given position of stream
+        static std::uint64_t random(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter)
+        {
+            std::uint32_t block[4];
+            generateBlock(seed, stream, counter >> 1, block);
+
+            return counter & 1 ? (std::uint64_t(block[3]) << 32) | block[2] : (std::uint64_t(block[1]) << 32) | block[0];
+        }
+
+        //Convert seed string to seed number
+        static std::uint64_t hashSeed(const std::string& seed);
+
+        //Derive independent stream from parent stream and index of child (for example chambers or tiles of tree)
+        static std::uint64_t getSubstream(std::uint64_t stream, std::uint64_t index);
+
+        //Next number of stream
+        std::uint64_t next()
+        {
+            if ((counter >> 1) != blockIndex)
+            {
+                blockIndex = counter >> 1;
+                generateBlock(seed, stream, blockIndex, block);
+            }
+
+            std::uint64_t value = counter & 1 ? (std::uint64_t(block[3]) << 32) | block[2] : (std::uint64_t(block[1]) << 32) | block[0];
+            counter++;
+
+            return value;
+        }
+
+        //Next 32 bits of stream, halves of 64-bit numbers are used one after another
+        std::uint32_t next32()
+        {
+            if (hasSpare)
+            {
+                hasSpare = false;
+
+                return spare;
+            }
+
+            std::uint64_t value = next();
+            spare = std::uint32_t(value >> 32);
+            hasSpare = true;
+
+            return std::uint32_t(value);
+        }
+
+        //Random number in [0, range) for ranges up to 2^32, it needs only half of 64-bit number
+        std::uint32_t getBounded32(std::uint64_t range)
+        {
+            std::uint64_t product = std::uint64_t(next32()) * range;
+
+            if (std::uint32_t(product) < range)
+            {
+                std::uint32_t threshold = std::uint32_t((std::uint64_t(1) << 32) % range);
+
+                while (std::uint32_t(product) < threshold)
+                {
+                    product = std::uint64_t(next32()) * range;
+                }
+            }
+
+            return std::uint32_t(product >> 32);
+        }
+
+        //Random number in [0, range), range 0 means whole 64-bit range
+        std::uint64_t getBounded(std::uint64_t range)
+        {
+            if (range == 0)
+            {
+                return next();
+            }
+
+            std::uint64_t high;
+            std::uint64_t low = multiply(next(), range, high);
+
+            //Reject numbers from incomplete last interval so all results have the same probability
+            if (low < range)
+            {
+                std::uint64_t threshold = (0 - range) % range;
+
+                while (low < threshold)
+                {
+                    low = multiply(next(), range, high);
+                }
+            }
+
+            return high;
+        }
+
+        //Random number in [min, max], small ranges (all maze coordinates in practice) use 32 bits
+        std::int64_t getNumber(std::int64_t min, std::int64_t max)
+        {
+            std::uint64_t range = std::uint64_t(max) - std::uint64_t(min) + 1;
+
+            if (range != 0 && range <= (std::uint64_t(1) << 32))
+            {
+                return min + std::int64_t(getBounded32(range));
+            }
+
+            return min + std::int64_t(getBounded(range));
+        }
+
+        //Fill array with next numbers of stream (same numbers as calling next() count times)
+        void fill(std::uint64_t* values, std::size_t count);
+
+        std::uint64_t getCounter() const { return counter; }
+
+        void setCounter(std::uint64_t counter)
+        {
+            this->counter = counter;
+            hasSpare = false;
+        }
+
+    private:
+        std::uint64_t seed, stream, counter;
+        std::uint64_t blockIndex; //Index of block that is in block array
+        std::uint32_t block[4];
+        std::uint32_t spare; //Unused high half of last number for next32()
+        bool hasSpare;
+
+        //Philox4x32-10 block, counter is (index, stream) and key is seed
+        static void generateBlock(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::uint32_t* output)
+        {
+            std::uint32_t counter[4] = { std::uint32_t(index), std::uint32_t(index >> 32), std::uint32_t(stream), std::uint32_t(stream >> 32) };
+            std::uint32_t key[2] = { std::uint32_t(seed), std::uint32_t(seed >> 32) };
+
+            for (unsigned int round = 0; round < 10; round++)
+            {
+                std::uint64_t product0 = std::uint64_t(0xD2511F53) * counter[0];
+                std::uint64_t product1 = std::uint64_t(0xCD9E8D57) * counter[2];
+
+                std::uint32_t next[4] = { std::uint32_t(product1 >> 32) ^ counter[1] ^ key[0], std::uint32_t(product1),
+                                          std::uint32_t(product0 >> 32) ^ counter[3] ^ key[1], std::uint32_t(product0) };
+
+                counter[0] = next[0];
+                counter[1] = next[1];
+                counter[2] = next[2];
+                counter[3] = next[3];
+
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+
+            output[0] = counter[0];
+            output[1] = counter[1];
+            output[2] = counter[2];
+            output[3] = counter[3];
+        }
+
+        //Full 128-bit product, returns low half and stores high half
+        static std::uint64_t multiply(std::uint64_t a, std::uint64_t b, std::uint64_t& high)
+        {
+            #if defined(_MSC_VER) && defined(_M_X64)
+                return _umul128(a, b, &high);
+            #elif defined(__SIZEOF_INT128__)
+                unsigned __int128 product = (unsigned __int128)a * b;
+                high = std::uint64_t(product >> 64);
+
+                return std::uint64_t(product);
+            #else
+                std::uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32, bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+                std::uint64_t lowLow = aLow * bLow, highLow = aHigh * bLow, lowHigh = aLow * bHigh;
+                std::uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + (lowHigh & 0xFFFFFFFF);
+
+                high = aHigh * bHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+
+                return a * b;
+            #endif
+        }
+};
+
+//Sequential SplitMix64 numbers for hot loops that need many numbers from one stream (like shuffle of all walls of tile)
+//It's several times faster than Philox, state is seeded from counter-based stream so numbers still depend only on seed and stream
+class MazeSequentialRandom
+{
+    public:
+        MazeSequentialRandom(MazeRandom& random)
+        {
+            state = random.next();
+        }
+
+        std::uint64_t next()
+        {
+            std::uint64_t value = state += 0x9E3779B97F4A7C15ULL;
+
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+            return value ^ (value >> 31);
+        }
+
+        //Random number in [0, range) for ranges up to 2^32 (Lemire's method with high half of number)
+        std::uint32_t getBounded32(std::uint64_t range)
+        {
+            std::uint64_t product = (next() >> 32) * range;
+
+            if (std::uint32_t(product) < range)
+            {
+                std::uint32_t threshold = std::uint32_t((std::uint64_t(1) << 32) % range);
+
+                while (std::uint32_t(product) < threshold)
+                {
+                    product = (next() >> 32) * range;
+                }
+            }
+
+            return std::uint32_t(product >> 32);
+        }
+
+    private:
+        std::uint64_t state;
+};
+
+#endif
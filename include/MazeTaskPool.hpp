@@ -0,0 +1,129 @@
+#ifndef MAZETASKPOOL_HPP
+#define MAZETASKPOOL_HPP
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Work-stealing pool for generator tasks
+//Every worker has its own deque, it takes newest tasks from its back and steals oldest (usually biggest) tasks from front of other deques
+//Tasks can push new tasks while they are processed, run() returns when there is no task left
+template <typename Task>
+class MazeTaskPool
+{
+    public:
+        MazeTaskPool(unsigned int threads)
+        {
+            if (threads == 0)
+            {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            for (unsigned int i = 0; i < threads; i++)
+            {
+                workers.emplace_back(new Worker());
+            }
+
+            pending = 0;
+        }
+
+        unsigned int getThreadCount() const
+        {
+            return workers.size();
+        }
+
+        //Add task to deque of worker (worker is index of thread that calls it)
+        void push(unsigned int worker, const Task& task)
+        {
+            pending++;
+
+            std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+            workers[worker]->tasks.push_back(task);
+        }
+
+        //Process task and all tasks pushed by it, process is called as process(task, worker)
+        template <typename Process>
+        void run(const Task& task, Process process)
+        {
+            push(0, task);
+
+            std::vector<std::thread> threads;
+
+            for (unsigned int i = 1; i < workers.size(); i++)
+            {
+                threads.emplace_back([this, i, &process]() { work(i, process); });
+            }
+
+            work(0, process);
+
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic<std::size_t> pending; //Tasks that are queued or processed right now
+
+        template <typename Process>
+        void work(unsigned int worker, Process& process)
+        {
+            Task task;
+
+            while (pending > 0)
+            {
+                if (take(worker, task))
+                {
+                    process(task, worker);
+                    pending--;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        bool take(unsigned int worker, Task& task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+
+                if (!workers[worker]->tasks.empty())
+                {
+                    task = workers[worker]->tasks.back();
+                    workers[worker]->tasks.pop_back();
+
+                    return true;
+                }
+            }
+
+            for (unsigned int i = 1; i < workers.size(); i++)
+            {
+                Worker& victim = *workers[(worker + i) % workers.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+
+                if (!victim.tasks.empty())
+                {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+};
+
+#endif
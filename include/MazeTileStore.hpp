@@ -0,0 +1,72 @@
+#ifndef MAZETILESTORE_HPP
+#define MAZETILESTORE_HPP
+
+#include "MazeGrid.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Read optimized maze array that keeps finished maze as independently compressed 64x64 tiles
+//Every tile row is run-length encoded (rows of generated mazes are mostly long runs), rows that can't be compressed are stored raw
+//Recently used tiles are kept decompressed in small LRU cache, so reads around camera don't decompress anything
+//Writes are supported but slow, changed tile is compressed again and appended (compact() removes old copies)
+class MazeTileStore : public MazeStorage
+{
+    public:
+        MazeTileStore(const MazeGridView& source, std::size_t cacheTiles = 16);
+
+        bool get(std::uint64_t row, std::uint64_t column) const
+        {
+            std::size_t tile = (row >> 6) * tilesPerRow + (column >> 6);
+
+            if (tile != lastTile)
+            {
+                lastWords = getTileWords(tile);
+                lastTile = tile;
+            }
+
+            return (lastWords[row & 63] >> (column & 63)) & 1;
+        }
+
+        void set(std::uint64_t row, std::uint64_t column, bool value);
+        void fill(bool value);
+        void compact();
+        std::size_t getMemoryUsage() const;
+        std::string getStatistics() const;
+
+        //Cache lookups, reads from the same tile as previous read don't look into cache and aren't counted
+        std::uint64_t getCacheHits() const;
+        std::uint64_t getCacheMisses() const;
+        std::size_t getCacheResidentBytes() const;
+        std::size_t getCompressedBytes() const;
+
+    private:
+        std::uint64_t size;
+        std::size_t tilesPerRow;
+
+        std::vector<std::uint8_t> data; //Compressed tiles one after another
+        std::vector<std::uint64_t> tileOffsets;
+        std::vector<std::uint16_t> tileSizes;
+        std::size_t staleBytes; //Bytes of tiles that were replaced by writes
+
+        //LRU cache of decompressed tiles, slot is 64 words
+        std::size_t cacheTiles;
+        mutable std::vector<std::uint64_t> cacheWords;
+        mutable std::vector<std::size_t> slotTiles;
+        mutable std::vector<std::uint64_t> slotUses;
+        mutable std::unordered_map<std::size_t, std::size_t> cachedSlots;
+        mutable std::uint64_t useCounter, cacheHits, cacheMisses;
+        mutable std::size_t lastTile, usedSlots;
+        mutable const std::uint64_t* lastWords;
+
+        const std::uint64_t* getTileWords(std::size_t tile) const;
+        void invalidateCache();
+
+        void encodeTile(const std::uint64_t* words, std::vector<std::uint8_t>& output) const;
+        void decodeTile(std::size_t tile, std::uint64_t* words) const;
+        void storeTile(std::size_t tile, const std::uint64_t* words);
+};
+
+#endif
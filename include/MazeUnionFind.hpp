@@ -0,0 +1,78 @@
+#ifndef MAZEUNIONFIND_HPP
+#define MAZEUNIONFIND_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//Disjoint sets in one flat array, with path halving and union by size
+//Entry of root has highest bit set and holds size of set, other entries hold index of parent
+class MazeUnionFind
+{
+    public:
+        //Make every element its own set
+        void reset(std::uint32_t count)
+        {
+            sets.assign(count, ROOT | 1);
+        }
+
+        std::uint32_t find(std::uint32_t element)
+        {
+            while (!(sets[element] & ROOT))
+            {
+                std::uint32_t parent = sets[element];
+
+                if (!(sets[parent] & ROOT))
+                {
+                    sets[element] = sets[parent];
+                }
+
+                element = sets[element];
+            }
+
+            return element;
+        }
+
+        //Join sets of both elements, returns false if they are already in the same set
+        bool unite(std::uint32_t first, std::uint32_t second)
+        {
+            first = find(first);
+            second = find(second);
+
+            if (first == second)
+            {
+                return false;
+            }
+
+            std::uint32_t size = (sets[first] & ~ROOT) + (sets[second] & ~ROOT);
+
+            if ((sets[first] & ~ROOT) < (sets[second] & ~ROOT))
+            {
+                std::swap(first, second);
+            }
+
+            sets[first] = ROOT | size;
+            sets[second] = first;
+
+            return true;
+        }
+
+        //Free memory of sets
+        void release()
+        {
+            std::vector<std::uint32_t>().swap(sets);
+        }
+
+        std::size_t getMemoryUsage() const
+        {
+            return sets.capacity() * sizeof(std::uint32_t);
+        }
+
+    private:
+        static const std::uint32_t ROOT = 0x80000000;
+
+        std::vector<std::uint32_t> sets;
+};
+
+#endif
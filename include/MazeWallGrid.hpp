@@ -0,0 +1,76 @@
+#ifndef MAZEWALLGRID_HPP
+#define MAZEWALLGRID_HPP
+
+#include "MazeGrid.hpp"
+
+#include <vector>
+
+//Maze array that stores walls on edges between maze fields instead of using whole fields for walls
+//Every maze field keeps two bits: wall on its east side and wall on its south side
+//It works only for mazes where fields are on odd indices and walls on even indices (like RD generator does)
+//Field coordinates used by get and set are the same as in MazeGrid so it can be used as drop-in storage:
+// - odd row and odd column is maze field (always empty)
+// - even row and even column is pillar between walls (always wall)
+// - odd row and even column is east wall of field on the left
+// - even row and odd column is south wall of field above
+// - border is always wall except for exit
+class MazeWallGrid : public MazeStorage
+{
+    public:
+        MazeWallGrid(std::uint64_t size);
+
+        bool get(std::uint64_t row, std::uint64_t column) const;
+        void set(std::uint64_t row, std::uint64_t column, bool value);
+        void fill(bool value);
+        std::size_t getMemoryUsage() const;
+
+        //Same as get without virtual call, for renderer and collisions that know they read WALLS storage
+        bool isWall(std::uint64_t row, std::uint64_t column) const
+        {
+            //Border
+            if (row == 0 || column == 0 || row >= size - 1 || column >= size - 1)
+            {
+                return !(exitOpen && row == exitRow && column == exitColumn);
+            }
+
+            if (row & 1)
+            {
+                if (column & 1) //Maze field
+                {
+                    return false;
+                }
+
+                return hasEastWall(row / 2, column / 2 - 1);
+            }
+
+            if (column & 1)
+            {
+                return hasSouthWall(row / 2 - 1, column / 2);
+            }
+
+            return true; //Pillar
+        }
+
+        //Direct wall queries using maze field coordinates (array index = field index * 2 + 1)
+        bool hasEastWall(std::uint64_t fieldRow, std::uint64_t fieldColumn) const
+        {
+            return (words[fieldRow * stride + (fieldColumn >> 5)] >> ((fieldColumn & 31) * 2)) & 1;
+        }
+
+        bool hasSouthWall(std::uint64_t fieldRow, std::uint64_t fieldColumn) const
+        {
+            return (words[fieldRow * stride + (fieldColumn >> 5)] >> ((fieldColumn & 31) * 2 + 1)) & 1;
+        }
+
+    private:
+        enum Wall { EAST = 0, SOUTH = 1 };
+
+        std::vector<std::uint64_t> words;
+        std::size_t stride;
+        std::uint64_t size, exitRow, exitColumn;
+        bool exitOpen;
+
+        void setWall(std::uint64_t fieldRow, std::uint64_t fieldColumn, Wall wall, bool value);
+};
+
+#endif
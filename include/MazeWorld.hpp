@@ -0,0 +1,84 @@
+#ifndef MAZEWORLD_HPP
+#define MAZEWORLD_HPP
+
+#include "MazeGrid.hpp"
+#include "MazeRandom.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Endless maze world that is generated in 64x64 field chunks only around one point (player)
+//Chunk is pure function of (seed, chunk row, chunk column): it owns its top wall row and left wall column with one opening in each
+//(position of opening is hashed from the same key), interior is recursive division maze, so neighbours always agree on shared borders
+//Chunks are generated by update() and evicted when they are far from the point, reads of chunks that are not resident return walls
+class MazeWorld : public MazeStorage
+{
+    public:
+        static const std::uint64_t CHUNK_FIELDS = 64;
+        static const std::uint64_t WORLD_SIZE = std::uint64_t(1) << 37; //Fields in row and column, chunk coordinates fit 31 bits
+
+        //Chunks up to radius chunks from chunk of point are resident (one more before they are evicted)
+        MazeWorld(std::uint64_t seed, std::uint64_t radius = 1);
+
+        bool get(std::uint64_t row, std::uint64_t column) const
+        {
+            if (row >= WORLD_SIZE || column >= WORLD_SIZE)
+            {
+                return true;
+            }
+
+            std::uint64_t chunk = getChunkKey(row / CHUNK_FIELDS, column / CHUNK_FIELDS);
+
+            if (chunk != lastChunk)
+            {
+                auto slot = chunkSlots.find(chunk);
+
+                if (slot == chunkSlots.end())
+                {
+                    return true;
+                }
+
+                lastChunk = chunk;
+                lastWords = &chunkWords[slot->second * CHUNK_FIELDS];
+            }
+
+            return (lastWords[row % CHUNK_FIELDS] >> (column % CHUNK_FIELDS)) & 1;
+        }
+
+        void set(std::uint64_t row, std::uint64_t column, bool value);
+        void fill(bool value);
+        std::size_t getMemoryUsage() const;
+        std::string getStatistics() const;
+
+        //Generate missing chunks around field and evict chunks that are too far from it
+        void update(std::uint64_t row, std::uint64_t column);
+
+        std::size_t getResidentChunks() const;
+        std::uint64_t getGeneratedChunks() const;
+
+    private:
+        std::uint64_t seed, radius;
+        std::uint64_t centerRow, centerColumn; //Chunk around which resident chunks are
+        bool hasCenter;
+        std::uint64_t generatedChunks, evictedChunks;
+
+        //Slots are allocated for all chunks that can be resident at once, so memory doesn't grow while walking
+        std::vector<std::uint64_t> chunkWords; //64 words per slot, bit is wall
+        std::vector<std::size_t> freeSlots;
+        std::unordered_map<std::uint64_t, std::size_t> chunkSlots;
+        std::vector<std::uint64_t> chambers; //Work stack of recursive division
+
+        mutable std::uint64_t lastChunk;
+        mutable const std::uint64_t* lastWords;
+
+        static std::uint64_t getChunkKey(std::uint64_t chunkRow, std::uint64_t chunkColumn)
+        {
+            return (chunkRow << 32) | chunkColumn;
+        }
+
+        void generateChunk(std::uint64_t chunkRow, std::uint64_t chunkColumn, std::uint64_t* words);
+};
+
+#endif
@@ -0,0 +1,98 @@
+#include "MazeChunkedGrid.hpp"
+
+#include <algorithm>
+
+//256x256 fields in chunk, every chunk row is 4 words
+static const std::size_t CHUNK_WORDS = 256 * 4;
+
+MazeChunkedGrid::MazeChunkedGrid(std::uint64_t size)
+{
+    chunksPerRow = (size + 255) / 256;
+    residentChunks = 0;
+
+    chunks.resize(chunksPerRow * chunksPerRow);
+    tags.assign(chunksPerRow * chunksPerRow, Tag::EMPTY);
+}
+
+void MazeChunkedGrid::set(std::uint64_t row, std::uint64_t column, bool value)
+{
+    std::size_t chunk = (row >> 8) * chunksPerRow + (column >> 8);
+    std::uint64_t* data = chunks[chunk].get();
+
+    if (data == nullptr)
+    {
+        //Nothing changes in uniform chunk
+        if (value == (tags[chunk] == Tag::WALL))
+        {
+            return;
+        }
+
+        data = new std::uint64_t[CHUNK_WORDS];
+        std::fill(data, data + CHUNK_WORDS, tags[chunk] == Tag::WALL ? ~std::uint64_t(0) : std::uint64_t(0));
+
+        chunks[chunk].reset(data);
+        residentChunks++;
+    }
+
+    std::uint64_t& word = data[(row & 255) * 4 + ((column & 255) >> 6)];
+    std::uint64_t mask = std::uint64_t(1) << (column & 63);
+
+    word = (word & ~mask) | ((std::uint64_t(0) - std::uint64_t(value)) & mask);
+}
+
+//Release all chunks and mark them as uniform
+void MazeChunkedGrid::fill(bool value)
+{
+    for (auto& chunk : chunks)
+    {
+        chunk.reset();
+    }
+
+    std::fill(tags.begin(), tags.end(), value ? Tag::WALL : Tag::EMPTY);
+    residentChunks = 0;
+}
+
+//Release allocated chunks which are uniform (all fields empty or all fields walls)
+void MazeChunkedGrid::compact()
+{
+    for (std::size_t i = 0; i < chunks.size(); i++)
+    {
+        std::uint64_t* data = chunks[i].get();
+
+        if (data == nullptr)
+        {
+            continue;
+        }
+
+        std::uint64_t first = data[0];
+
+        if ((first != 0 && first != ~std::uint64_t(0)) || std::find_if(data, data + CHUNK_WORDS, [first](std::uint64_t word) { return word != first; }) != data + CHUNK_WORDS)
+        {
+            continue;
+        }
+
+        tags[i] = first ? Tag::WALL : Tag::EMPTY;
+        chunks[i].reset();
+        residentChunks--;
+    }
+}
+
+std::size_t MazeChunkedGrid::getMemoryUsage() const
+{
+    return residentChunks * CHUNK_WORDS * sizeof(std::uint64_t) + chunks.size() * (sizeof(chunks[0]) + sizeof(tags[0]));
+}
+
+std::string MazeChunkedGrid::getStatistics() const
+{
+    return "resident chunks " + std::to_string(residentChunks) + " of " + std::to_string(chunks.size());
+}
+
+std::size_t MazeChunkedGrid::getResidentChunks() const
+{
+    return residentChunks;
+}
+
+std::size_t MazeChunkedGrid::getChunkCount() const
+{
+    return chunks.size();
+}
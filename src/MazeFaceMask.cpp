@@ -0,0 +1,180 @@
+#include "MazeFaceMask.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define GLMAZE_SSE2
+    #include <emmintrin.h>
+#endif
+
+MazeFaceMask::MazeFaceMask(const MazeGridView& mazeArray, std::uint64_t exitRow, std::uint64_t exitColumn, const MazeWallGrid* wallGrid)
+{
+    this->mazeArray = mazeArray;
+    this->wallGrid = wallGrid;
+    this->exitRow = exitRow;
+    this->exitColumn = exitColumn;
+
+    size = mazeArray.getRows();
+    stride = (size + 63) / 64;
+}
+
+void MazeFaceMask::build(unsigned int threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    planes.assign(size * stride * 4, 0);
+
+    //Every thread writes its own rows, rows never share words
+    std::uint64_t bandRows = (size + threads - 1) / threads;
+    std::vector<std::thread> workers;
+
+    for (std::uint64_t startRow = bandRows; startRow < size; startRow += bandRows)
+    {
+        workers.emplace_back(&MazeFaceMask::buildRows, this, startRow, std::min(startRow + bandRows, size));
+    }
+
+    buildRows(0, std::min(bandRows, size));
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+bool MazeFaceMask::isBuilt() const
+{
+    return !planes.empty();
+}
+
+std::size_t MazeFaceMask::getMemoryUsage() const
+{
+    return planes.size() * sizeof(std::uint64_t);
+}
+
+//Same result as bitplanes, but read directly from maze array
+std::uint8_t MazeFaceMask::deriveMask(std::uint64_t row, std::uint64_t column) const
+{
+    if (wallGrid != nullptr)
+    {
+        return deriveWallMask(row, column);
+    }
+
+    if (mazeArray.get(row, column))
+    {
+        return 0;
+    }
+
+    return mazeArray.get(row, column - 1) | (mazeArray.get(row, column + 1) << 1) |
+           (mazeArray.get(row - 1, column) << 2) | (mazeArray.get(row + 1, column) << 3);
+}
+
+//Mask of field from WALLS storage, maze field reads its four walls from two words
+//Field between two maze fields is empty only when its wall bit is clear and it has faces only towards pillars
+std::uint8_t MazeFaceMask::deriveWallMask(std::uint64_t row, std::uint64_t column) const
+{
+    std::uint64_t fieldRow = row / 2;
+    std::uint64_t fieldColumn = column / 2;
+
+    if ((row & 1) && (column & 1))
+    {
+        bool left = column == 1 ? wallGrid->isWall(row, 0) : wallGrid->hasEastWall(fieldRow, fieldColumn - 1);
+        bool right = column + 2 == size ? wallGrid->isWall(row, column + 1) : wallGrid->hasEastWall(fieldRow, fieldColumn);
+        bool front = row == 1 ? wallGrid->isWall(0, column) : wallGrid->hasSouthWall(fieldRow - 1, fieldColumn);
+        bool back = row + 2 == size ? wallGrid->isWall(row + 1, column) : wallGrid->hasSouthWall(fieldRow, fieldColumn);
+
+        return left | (right << 1) | (front << 2) | (back << 3);
+    }
+
+    if (wallGrid->isWall(row, column))
+    {
+        return 0;
+    }
+
+    if (row & 1)
+    {
+        return (wallGrid->isWall(row - 1, column) << 2) | (wallGrid->isWall(row + 1, column) << 3);
+    }
+
+    return wallGrid->isWall(row, column - 1) | (wallGrid->isWall(row, column + 1) << 1);
+}
+
+//Read row of maze as words, fields outside of maze are walls
+void MazeFaceMask::readRow(std::int64_t row, std::uint64_t* words) const
+{
+    if (row < 0 || row >= std::int64_t(size))
+    {
+        std::fill(words, words + stride, ~std::uint64_t(0));
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < stride; i++)
+    {
+        words[i] = mazeArray.getBits(row, i * 64);
+    }
+
+    if (size % 64 != 0)
+    {
+        words[stride - 1] |= ~std::uint64_t(0) << (size % 64);
+    }
+}
+
+//Faces for 64 fields are computed at once with word operations (left and right neighbours are shifted row)
+//With SSE2 two words are processed at once
+void MazeFaceMask::buildRows(std::uint64_t startRow, std::uint64_t endRow)
+{
+    //Every row buffer has one wall word before and after row, so neighbour words can be read without checks
+    std::vector<std::uint64_t> buffer((stride + 2) * 3, ~std::uint64_t(0));
+    std::uint64_t* above = buffer.data() + 1;
+    std::uint64_t* current = above + stride + 2;
+    std::uint64_t* below = current + stride + 2;
+
+    readRow(std::int64_t(startRow) - 1, above);
+    readRow(startRow, current);
+
+    for (std::uint64_t row = startRow; row < endRow; row++)
+    {
+        readRow(row + 1, below);
+
+        std::uint64_t* words = &planes[row * stride * 4];
+        std::size_t i = 0;
+
+        #if defined(GLMAZE_SSE2)
+            for (; i + 2 <= stride; i += 2)
+            {
+                __m128i fields = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i));
+                __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i - 1));
+                __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i + 1));
+
+                __m128i left = _mm_andnot_si128(fields, _mm_or_si128(_mm_slli_epi64(fields, 1), _mm_srli_epi64(previous, 63)));
+                __m128i right = _mm_andnot_si128(fields, _mm_or_si128(_mm_srli_epi64(fields, 1), _mm_slli_epi64(next, 63)));
+                __m128i front = _mm_andnot_si128(fields, _mm_loadu_si128(reinterpret_cast<const __m128i*>(above + i)));
+                __m128i back = _mm_andnot_si128(fields, _mm_loadu_si128(reinterpret_cast<const __m128i*>(below + i)));
+
+                __m128i* output = reinterpret_cast<__m128i*>(words + i * 4);
+
+                _mm_storeu_si128(output, _mm_unpacklo_epi64(left, right));
+                _mm_storeu_si128(output + 1, _mm_unpacklo_epi64(front, back));
+                _mm_storeu_si128(output + 2, _mm_unpackhi_epi64(left, right));
+                _mm_storeu_si128(output + 3, _mm_unpackhi_epi64(front, back));
+            }
+        #endif
+
+        for (; i < stride; i++)
+        {
+            std::uint64_t empty = ~current[i];
+
+            words[i * 4] = empty & ((current[i] << 1) | (current[i - 1] >> 63)); //Left
+            words[i * 4 + 1] = empty & ((current[i] >> 1) | (current[i + 1] << 63)); //Right
+            words[i * 4 + 2] = empty & above[i]; //Front
+            words[i * 4 + 3] = empty & below[i]; //Back
+        }
+
+        std::swap(above, current);
+        std::swap(current, below);
+    }
+}
@@ -1,37 +1,169 @@
 #include "MazeGenerator.hpp"
+#include "MazeWallGrid.hpp"
+#include "MazeChunkedGrid.hpp"
+#include "MazeTileStore.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 
-MazeGenerator::MazeGenerator(unsigned int size, std::string seed)
+MazeGenerator::MazeGenerator(std::uint64_t size, std::string seed)
 {
     mazeSize = size;
+    startX = 0; //Start and exit are set by generator, cancelled generation leaves them in corner
+    startY = 0;
+    endX = 0;
+    endY = 0;
+    arrayAllocated = false;
+    wallStorageSupported = false;
+    parallelSupported = false;
+    peakStackSize = 0;
+    threadCount = 0;
+    storageType = Storage::BITS;
+    progressDone = 0;
+    progressTotal = 0;
+    cancelRequested = false;
+    stepState = StepState::STARTING;
 
     if (seed.empty()) //Use time as seed
     {
         unsigned timeSeed = std::chrono::system_clock::now().time_since_epoch().count();
         randomEngine.seed(timeSeed);
+        seedKey = timeSeed;
     }
     else //Use provided seed
     {
         std::seed_seq stringSeed(seed.begin(), seed.end());
         randomEngine.seed(stringSeed);
+        seedKey = MazeRandom::hashSeed(seed);
     }
 }
 
 MazeGenerator::~MazeGenerator()
 {
-    //Clean up array memory
-    for(unsigned int i = 0; i < mazeSize; ++i) 
-        delete [] mazeArray[i];
+}
+
+//Select how maze array is stored, it needs to be called before generateMaze
+//Returns false if generator can't use selected storage, WALLS and CHUNKED storage can't be written by more threads set by setThreads
+bool MazeGenerator::setStorage(Storage storage)
+{
+    if (arrayAllocated || (storage == Storage::WALLS && !wallStorageSupported) ||
+        (threadCount > 0 && (storage == Storage::WALLS || storage == Storage::CHUNKED)))
+    {
+        return false;
+    }
+
+    storageType = storage;
+
+    return true;
+}
+
+//Keep maze array in memory-mapped file instead of heap (only for BITS storage), it needs to be called before generateMaze
+//File is created or resized when array is allocated, empty path disables it
+void MazeGenerator::setMazeFile(std::string path)
+{
+    mazeFile = path;
+}
+
+//Generate maze with given count of threads (0 disables parallel generation), it needs to be called before generateMaze
+//Parallel generation uses different random streams than serial one, so the same seed gives different maze, but it doesn't depend on count of threads
+//Returns false if generator or selected storage can't be generated in parallel
+bool MazeGenerator::setThreads(unsigned int threads)
+{
+    if (arrayAllocated || (threads > 0 && (!parallelSupported || storageType == Storage::WALLS || storageType == Storage::CHUNKED)))
+    {
+        return false;
+    }
+
+    threadCount = threads;
+
+    return true;
+}
+
+//Allocate maze array for current maze size and selected storage
+//Generators call it at the beginning of generateMaze, array is allocated only once
+void MazeGenerator::allocateArray(bool clearArray)
+{
+    if (arrayAllocated)
+    {
+        return;
+    }
+
+    if (storageType == Storage::WALLS)
+    {
+        storage.reset(new MazeWallGrid(mazeSize));
+    }
+    else if (storageType == Storage::CHUNKED)
+    {
+        storage.reset(new MazeChunkedGrid(mazeSize));
+    }
+    else if (mazeFile.empty() || !mazeArray.allocateMapped(mazeSize, mazeSize, mazeFile))
+    {
+        if (!mazeFile.empty())
+        {
+            std::cerr << "Using memory instead of maze file" << std::endl;
+        }
 
-    delete [] mazeArray;
+        mazeArray.allocate(mazeSize, mazeSize, clearArray);
+    }
+
+    arrayAllocated = true;
+}
+
+void MazeGenerator::fillFields(bool value)
+{
+    if (storage)
+    {
+        storage->fill(value);
+    }
+    else
+    {
+        mazeArray.fill(value);
+    }
+}
+
+//Set fields [startColumn, endColumn) of row, with BITS storage whole words are written at once
+void MazeGenerator::fillRowFields(std::uint64_t row, std::uint64_t startColumn, std::uint64_t endColumn, bool value)
+{
+    if (storage)
+    {
+        for (std::uint64_t column = startColumn; column < endColumn; column++)
+        {
+            storage->set(row, column, value);
+        }
+    }
+    else
+    {
+        mazeArray.fillRow(row, startColumn, endColumn, value);
+    }
+}
+
+//Set fields [startRow, endRow) of column
+void MazeGenerator::fillColumnFields(std::uint64_t column, std::uint64_t startRow, std::uint64_t endRow, bool value)
+{
+    if (storage)
+    {
+        for (std::uint64_t row = startRow; row < endRow; row++)
+        {
+            storage->set(row, column, value);
+        }
+    }
+    else
+    {
+        mazeArray.fillColumn(column, startRow, endRow, value);
+    }
 }
 
 //Get random value in provided range
-int MazeGenerator::getRandomNumber(int min, int max)
+std::int64_t MazeGenerator::getRandomNumber(std::int64_t min, std::int64_t max)
+{
+    return std::uniform_int_distribution<std::int64_t>{min, max}(randomEngine);
+}
+
+//Get counter-based random stream, numbers depend only on seed, stream index and position in stream
+MazeRandom MazeGenerator::getRandomStream(std::uint64_t stream)
 {
-    return std::uniform_int_distribution<int>{min, max}(randomEngine);
+    return MazeRandom(seedKey, stream);
 }
 
 //Set start position for maze
@@ -42,7 +174,7 @@ void MazeGenerator::setStartPosition()
     startY = getRandomNumber(1, mazeSize - 1);
 
     //Generate until start position will be empty field inside maze
-    while (mazeArray[startY][startX])
+    while (getField(startY, startX))
     {
         startX = getRandomNumber(1, mazeSize - 1);
         startY = getRandomNumber(1, mazeSize - 1);
@@ -58,54 +190,54 @@ void MazeGenerator::setExit()
 
     while (!foundExit)
     {
-        int exitIndex = getRandomNumber(1, mazeSize - 1);
+        std::uint64_t exitIndex = getRandomNumber(1, mazeSize - 1);
         Direction exitWall = MazeGenerator::Direction(getRandomNumber(0, 3));
 
         switch (exitWall)
         {
             case Direction::TOP:
-                if (mazeArray[1][exitIndex] == false)
+                if (!getField(1, exitIndex))
                 {
                     endX = exitIndex;
                     endY = 1;
                     endBorder = Direction::TOP;
-                    mazeArray[0][exitIndex] = false;
+                    setField(0, exitIndex, false);
                     foundExit = true;
                 }
 
                 break;
 
             case Direction::BOTTOM:
-                if (mazeArray[mazeSize - 2][exitIndex] == false)
+                if (!getField(mazeSize - 2, exitIndex))
                 {
                     endX = exitIndex;
                     endY = mazeSize - 2;
                     endBorder = Direction::BOTTOM;
-                    mazeArray[mazeSize - 1][exitIndex] = false;
+                    setField(mazeSize - 1, exitIndex, false);
                     foundExit = true;
                 }
 
                 break;
 
             case Direction::LEFT:
-                if (mazeArray[exitIndex][1] == false)
+                if (!getField(exitIndex, 1))
                 {
                     endX = 1;
                     endY = exitIndex;
                     endBorder = Direction::LEFT;
-                    mazeArray[exitIndex][0] = false;
+                    setField(exitIndex, 0, false);
                     foundExit = true;
                 }
 
                 break;
 
             case Direction::RIGHT:
-                if (mazeArray[exitIndex][mazeSize - 2] == false)
+                if (!getField(exitIndex, mazeSize - 2))
                 {
                     endX = mazeSize - 2;
                     endY = exitIndex;
                     endBorder = Direction::RIGHT;
-                    mazeArray[exitIndex][mazeSize - 1] = false;
+                    setField(exitIndex, mazeSize - 1, false);
                     foundExit = true;
                 }
 
@@ -114,32 +246,37 @@ void MazeGenerator::setExit()
     }
 }
 
-bool** MazeGenerator::getMazeArray()
+MazeGridView MazeGenerator::getMazeArray()
 {
-    return mazeArray;
+    if (storage)
+    {
+        return MazeGridView(storage.get(), mazeSize, mazeSize);
+    }
+
+    return mazeArray.getView();
 }
 
-unsigned int MazeGenerator::getMazeSize()
+std::uint64_t MazeGenerator::getMazeSize()
 {
     return mazeSize;
 }
 
-unsigned int MazeGenerator::getStartX()
+std::uint64_t MazeGenerator::getStartX()
 {
     return startX;
 }
 
-unsigned int MazeGenerator::getStartY()
+std::uint64_t MazeGenerator::getStartY()
 {
     return startY;
 }
 
-unsigned int MazeGenerator::getEndX()
+std::uint64_t MazeGenerator::getEndX()
 {
     return endX;
 }
 
-unsigned int MazeGenerator::getEndY()
+std::uint64_t MazeGenerator::getEndY()
 {
     return endY;
 }
@@ -148,3 +285,107 @@ MazeGenerator::Direction MazeGenerator::getEndBorder()
 {
     return endBorder;
 }
+
+MazeGenerator::Storage MazeGenerator::getStorage()
+{
+    return storageType;
+}
+
+//Get WALLS storage for direct wall queries, nullptr with other storages or before array is allocated
+const MazeWallGrid* MazeGenerator::getWallGrid()
+{
+    return storageType == Storage::WALLS ? static_cast<const MazeWallGrid*>(storage.get()) : nullptr;
+}
+
+//Get memory used by maze array in bytes
+std::size_t MazeGenerator::getMemoryUsage()
+{
+    if (storage)
+    {
+        return storage->getMemoryUsage();
+    }
+
+    return mazeArray.getMemoryUsage();
+}
+
+std::string MazeGenerator::getStorageStatistics()
+{
+    if (storage)
+    {
+        return storage->getStatistics();
+    }
+
+    return "";
+}
+
+//Get peak count of entries on work stack of last generation (0 for generators without stack)
+std::size_t MazeGenerator::getPeakStackSize()
+{
+    return peakStackSize;
+}
+
+//Release storage memory that is not needed anymore, called after generateMaze
+//COMPRESSED maze is generated as bits and here it's compressed into tiles and bit array is freed
+void MazeGenerator::compactArray()
+{
+    if (storageType == Storage::COMPRESSED && arrayAllocated && !storage)
+    {
+        storage.reset(new MazeTileStore(mazeArray.getView()));
+        mazeArray.release();
+    }
+
+    if (storage)
+    {
+        storage->compact();
+    }
+}
+
+bool MazeGenerator::step(std::uint64_t)
+{
+    generateMaze();
+
+    return true;
+}
+
+bool MazeGenerator::stepFor(std::chrono::microseconds time)
+{
+    auto end = std::chrono::steady_clock::now() + time;
+
+    do
+    {
+        if (step(STEP_SLICE))
+        {
+            return true;
+        }
+    } while (std::chrono::steady_clock::now() < end);
+
+    return false;
+}
+
+double MazeGenerator::getProgress()
+{
+    std::uint64_t total = progressTotal.load(std::memory_order_relaxed);
+
+    if (total == 0)
+    {
+        return 0.0;
+    }
+
+    return std::min(1.0, double(progressDone.load(std::memory_order_relaxed)) / double(total));
+}
+
+void MazeGenerator::cancel()
+{
+    cancelRequested.store(true, std::memory_order_relaxed);
+}
+
+bool MazeGenerator::isCancelled()
+{
+    return cancelRequested.load(std::memory_order_relaxed);
+}
+
+void MazeGenerator::startProgress(std::uint64_t total)
+{
+    progressDone.store(0, std::memory_order_relaxed);
+    progressTotal.store(std::max<std::uint64_t>(total, 1), std::memory_order_relaxed);
+}
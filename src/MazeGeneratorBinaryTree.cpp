@@ -0,0 +1,29 @@
+#include "MazeGeneratorBinaryTree.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+#include <algorithm>
+
+MazeGeneratorBinaryTree::MazeGeneratorBinaryTree(std::uint64_t size, std::string seed)
+: MazeGeneratorRows(size, seed)
+{
+}
+
+//Set bit means passage up and wall left, first cell of row always goes up
+void MazeGeneratorBinaryTree::carveRow(std::uint64_t cellRow, MazeSequentialRandom& random, RowWork& work)
+{
+    fillCellBits(work, cellRow == 0 ? nullptr : &random);
+    spreadBits(work.cellBits.data(), work.cellWords.data(), work.cellBits.size(), false);
+
+    if (cellRow == 0)
+    {
+        //Top row is corridor under top border
+        std::fill(work.wallWords.begin(), work.wallWords.end(), ~std::uint64_t(0));
+    }
+    else
+    {
+        spreadBits(work.cellBits.data(), work.wallWords.data(), work.cellBits.size(), true);
+    }
+}
+
+static MazeGeneratorRegistrar registrar("BINARYTREE", "Binary tree, corridors along top and left border", "", MazeGeneratorInfo::PARALLEL | MazeGeneratorInfo::WALL_STORAGE | MazeGeneratorInfo::BIASED, 4800.0, 155.0, 0.0,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorBinaryTree(size, seed); });
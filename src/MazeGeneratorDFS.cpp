@@ -1,127 +1,202 @@
 #include "MazeGeneratorDFS.hpp"
+#include "MazeGeneratorRegistry.hpp"
 
 #include <algorithm>
 
-MazeGeneratorDFS::MazeGeneratorDFS(unsigned int size, std::string seed)
+MazeGeneratorDFS::MazeGeneratorDFS(std::uint64_t size, std::string seed)
 : MazeGenerator(size, seed)
 {
     mazeSize = size;
 
     mazeSize += 2;
-
-    allocateArray();
 }
 
-void MazeGeneratorDFS::allocateArray()
+void MazeGeneratorDFS::generateMaze()
 {
-    mazeArray = new bool*[mazeSize];
-    
-    for(unsigned int i = 0; i < mazeSize; ++i)
-        mazeArray[i] = new bool[mazeSize];
+    stepState = StepState::STARTING;
+
+    step(~std::uint64_t(0));
 }
 
-void MazeGeneratorDFS::generateMaze()
+//Every unit of budget is one tried move
+bool MazeGeneratorDFS::step(std::uint64_t budget)
 {
-    //Clear array
-    for(unsigned int i = 0; i < mazeSize; i++)
+    if (stepState == StepState::FINISHED)
     {
-        for(unsigned int j = 0; j < mazeSize; j++)
-        {
-            mazeArray[i][j] = true;
-        }
+        return true;
     }
 
-    unsigned int x, y, direction;
+    if (stepState == StepState::STARTING)
+    {
+        //Array is filled with walls here, so allocation doesn't clear it first
+        allocateArray(false);
+        fillFields(true);
 
-    x = getRandomNumber(3, mazeSize - 3);
-    y = getRandomNumber(3, mazeSize - 3);
-    direction = getRandomNumber(1, 4);
+        pathX = getRandomNumber(3, mazeSize - 3);
+        pathY = getRandomNumber(3, mazeSize - 3);
+        pathMove = Move(getRandomNumber(1, 4) - 1);
 
-    mazeArray[x][y] = false;
+        setField(pathX, pathY, false);
 
-    switch (direction)
+        //About 58% of inner fields are carved in DFS maze
+        startProgress((mazeSize - 2) * (mazeSize - 2) / 100 * 58);
+
+        pathStack.clear();
+        peakStackSize = 0;
+        carvedFields = 1;
+
+        stepState = StepState::RUNNING;
+    }
+
+    if (!carvePath(budget))
     {
-        case 1: //Up
-            addPath(x, y - 1);
-            break;
+        return false;
+    }
 
-        case 2: //Down
-            addPath(x, y + 1);
-            break;
-        
-        case 3: //Left
-            addPath(x - 1, y);
-            break;
+    pathStack.clear();
+    pathStack.shrink_to_fit();
 
-        case 4: //Right
-            addPath(x + 1, y);
-            break;
+    stepState = StepState::FINISHED;
+
+    if (!isCancelled())
+    {
+        setExit();
+        setStartPosition();
     }
 
-    setExit();
-    setStartPosition();
+    return true;
 }
 
-
-void MazeGeneratorDFS::addPath(unsigned int x, unsigned int y)
+//Field can be carved if it's inside maze, it's not visited yet and it has at most one empty neighbour
+bool MazeGeneratorDFS::canCarve(std::uint64_t x, std::uint64_t y)
 {
     //Check if we are out of bonds
     if (x >= mazeSize - 1 || x < 1 || y < 1 || y >= mazeSize - 1)
     {
-        return;
+        return false;
     }
 
     //Check if this cell was visited
-    if (!mazeArray[x][y])
-        return;
+    if (!getField(x, y))
+    {
+        return false;
+    }
 
     //Count visited neighbours
-    int count = 0;
-
-    if (mazeArray[x - 1][y] == false)
-        count++;
-
-    if (mazeArray[x + 1][y] == false)
-        count++;
-
-    if (mazeArray[x][y - 1] == false)
-        count++;
-
-    if (mazeArray[x][y + 1] == false)
-        count++;
-
-    if (count > 1)
-        return;
+    int count = !getField(x - 1, y) + !getField(x + 1, y) + !getField(x, y - 1) + !getField(x, y + 1);
 
-    mazeArray[x][y] = false;
+    return count <= 1;
+}
 
-    //Add directions to list
-    directions.push_back(1);
-    directions.push_back(2);
-    directions.push_back(3);
-    directions.push_back(4);
+//Carve paths with depth first search, continuing by next move from current position, returns true when search is finished
+//Every stack entry is one cell of current path, bits 0-3 are directions that weren't tried yet and bits 4-5 are move that entered the cell
+//Next direction is picked randomly from remaining ones, which is the same as going through shuffled list of directions
+bool MazeGeneratorDFS::carvePath(std::uint64_t budget)
+{
+    static const int directionCounts[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
 
-    std::shuffle(directions.begin(), directions.end(), randomEngine);
+    //Position is kept in locals while carving
+    std::uint64_t x = pathX, y = pathY;
+    Move move = pathMove;
+    bool finished = false;
 
-    for (unsigned int i = 0; i < directions.size(); i++)
+    for (; budget > 0; budget--)
     {
-        switch (directions[i])
+        std::uint64_t nextX = x, nextY = y;
+
+        switch (move)
         {
-            case 1: //Up
-                addPath(x, y - 1);
+            case Move::UP:
+                nextY--;
                 break;
 
-            case 2: //Down
-                addPath(x, y + 1);
+            case Move::DOWN:
+                nextY++;
                 break;
 
-            case 3: //Left
-                addPath(x - 1, y);
+            case Move::LEFT:
+                nextX--;
                 break;
 
-            case 4: //Right
-                addPath(x + 1, y);
+            case Move::RIGHT:
+                nextX++;
                 break;
         }
+
+        if (canCarve(nextX, nextY))
+        {
+            setField(nextX, nextY, false);
+
+            x = nextX;
+            y = nextY;
+
+            //There is no need to try way back (opposite move differs only in lowest bit)
+            pathStack.push_back((0xF & ~(1 << (move ^ 1))) | (move << 4));
+            peakStackSize = std::max(peakStackSize, pathStack.size());
+
+            if (++carvedFields % PROGRESS_STEP == 0)
+            {
+                setProgress(carvedFields);
+
+                if (isCancelled())
+                {
+                    finished = true;
+                    break;
+                }
+            }
+        }
+
+        //Go back until some cell on path has directions left
+        while (!pathStack.empty() && (pathStack.back() & 0xF) == 0)
+        {
+            switch (Move(pathStack.back() >> 4))
+            {
+                case Move::UP:
+                    y++;
+                    break;
+
+                case Move::DOWN:
+                    y--;
+                    break;
+
+                case Move::LEFT:
+                    x++;
+                    break;
+
+                case Move::RIGHT:
+                    x--;
+                    break;
+            }
+
+            pathStack.pop_back();
+        }
+
+        if (pathStack.empty())
+        {
+            finished = true;
+            break;
+        }
+
+        //Pick random direction from remaining ones
+        std::uint8_t& cell = pathStack.back();
+        int pick = getRandomNumber(0, directionCounts[cell & 0xF] - 1);
+        int direction = 0;
+
+        while (!(cell & (1 << direction)) || pick-- > 0)
+        {
+            direction++;
+        }
+
+        cell &= ~(1 << direction);
+        move = Move(direction);
     }
+
+    pathX = x;
+    pathY = y;
+    pathMove = move;
+
+    return finished;
 }
+
+static MazeGeneratorRegistrar registrar("DFS", "Depth-first search, long winding corridors", "", MazeGeneratorInfo::RESUMABLE, 10.0, 0.0, 0.1,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorDFS(size, seed); });
@@ -0,0 +1,273 @@
+#include "MazeGeneratorEller.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+//Label of cell that isn't connected to row above
+static const std::uint32_t NO_SET = 0xFFFFFFFF;
+
+MazeGeneratorEller::MazeGeneratorEller(std::uint64_t size, std::string seed)
+: MazeGenerator(size, seed)
+{
+    mazeSize = size;
+
+    if (mazeSize % 2 == 0) //Cells are on odd indices and walls on even ones like in RD
+    {
+        mazeSize++;
+    }
+
+    rowCount = mazeSize;
+    wallStorageSupported = true;
+}
+
+void MazeGeneratorEller::setRowSink(RowSink sink, std::uint64_t rows)
+{
+    rowSink = sink;
+    rowCount = rows == 0 ? mazeSize : std::max<std::uint64_t>(rows, 3) | 1; //Maze needs at least one row of cells
+}
+
+void MazeGeneratorEller::generateMaze()
+{
+    std::uint64_t cellColumns = (mazeSize - 1) / 2;
+    std::uint64_t cellRows = (rowCount - 1) / 2;
+
+    if (cellColumns >= NO_SET)
+    {
+        std::cerr << "Maze is too wide for Eller generator" << std::endl;
+        return;
+    }
+
+    if (cellColumns == 0 || cellRows == 0)
+    {
+        std::cerr << "Maze is too small for Eller generator" << std::endl;
+        return;
+    }
+
+    //writeRow writes every word of every row, so array isn't cleared
+    if (!rowSink)
+    {
+        allocateArray(false);
+    }
+
+    cellSets.assign(cellColumns, NO_SET);
+    setParents.assign(cellColumns, 0);
+    setCells.assign(cellColumns, 0);
+    usedStamps.assign(cellColumns, 0);
+    downStamps.assign(cellColumns, 0);
+    rowWords.assign((mazeSize + 63) / 64, 0);
+
+    //Rows are written only once, so exit and start are chosen before generation (every cell of perfect maze is empty)
+    endBorder = Direction(getRandomNumber(0, 3));
+    std::uint64_t exitIndex = getRandomNumber(0, (endBorder == Direction::LEFT || endBorder == Direction::RIGHT ? cellRows : cellColumns) - 1) * 2 + 1;
+
+    endX = endBorder == Direction::LEFT ? 1 : (endBorder == Direction::RIGHT ? mazeSize - 2 : exitIndex);
+    endY = endBorder == Direction::TOP ? 1 : (endBorder == Direction::BOTTOM ? rowCount - 2 : exitIndex);
+
+    startX = getRandomNumber(0, cellColumns - 1) * 2 + 1;
+    startY = getRandomNumber(0, cellRows - 1) * 2 + 1;
+
+    //Top border
+    std::fill(rowWords.begin(), rowWords.end(), ~std::uint64_t(0));
+    writeRow(0);
+
+    startProgress(cellRows);
+
+    for (std::uint64_t cellRow = 0; cellRow < cellRows; cellRow++)
+    {
+        bool lastRow = cellRow == cellRows - 1;
+
+        //Every row has its own random stream, so rows don't depend on random numbers used by rows before them
+        MazeRandom random = getRandomStream(cellRow);
+        std::uint64_t randomBits = 0;
+        unsigned int randomBitCount = 0;
+
+        auto getRandomBit = [&]()
+        {
+            if (randomBitCount == 0)
+            {
+                randomBits = random.next();
+                randomBitCount = 64;
+            }
+
+            bool bit = randomBits & 1;
+            randomBits >>= 1;
+            randomBitCount--;
+
+            return bit;
+        };
+
+        assignSets(cellRow);
+
+        //Cell row, cells are empty and walls between them are removed when neighbour sets are joined
+        //In last row all different sets are joined, so whole maze is connected
+        std::fill(rowWords.begin(), rowWords.end(), ~std::uint64_t(0));
+
+        for (std::uint64_t cell = 0; cell < cellColumns; cell++)
+        {
+            std::uint64_t column = cell * 2 + 1;
+            rowWords[column >> 6] &= ~(std::uint64_t(1) << (column & 63));
+
+            if (cell + 1 < cellColumns)
+            {
+                std::uint32_t set = findSet(cellSets[cell]);
+                std::uint32_t nextSet = findSet(cellSets[cell + 1]);
+
+                if (set != nextSet && (lastRow || getRandomBit()))
+                {
+                    setParents[nextSet] = set;
+                    rowWords[(column + 1) >> 6] &= ~(std::uint64_t(1) << ((column + 1) & 63));
+                }
+            }
+        }
+
+        writeRow(cellRow * 2 + 1);
+
+        //Row of walls below cells, every set needs at least one passage down (it's forced on last cell of set without one)
+        std::fill(rowWords.begin(), rowWords.end(), ~std::uint64_t(0));
+
+        if (!lastRow)
+        {
+            for (std::uint64_t cell = 0; cell < cellColumns; cell++)
+            {
+                std::uint32_t set = findSet(cellSets[cell]);
+                cellSets[cell] = set;
+                setCells[set] = 0;
+            }
+
+            for (std::uint64_t cell = 0; cell < cellColumns; cell++)
+            {
+                setCells[cellSets[cell]]++;
+            }
+
+            for (std::uint64_t cell = 0; cell < cellColumns; cell++)
+            {
+                std::uint32_t set = cellSets[cell];
+                setCells[set]--;
+
+                if (getRandomBit() || (setCells[set] == 0 && downStamps[set] != cellRow + 1))
+                {
+                    downStamps[set] = cellRow + 1;
+
+                    std::uint64_t column = cell * 2 + 1;
+                    rowWords[column >> 6] &= ~(std::uint64_t(1) << (column & 63));
+                }
+                else
+                {
+                    cellSets[cell] = NO_SET;
+                }
+            }
+        }
+
+        writeRow(cellRow * 2 + 2);
+
+        //Rows are long enough to report every one of them
+        setProgress(cellRow + 1);
+
+        if (isCancelled())
+        {
+            break;
+        }
+    }
+
+    cellSets.clear();
+    setParents.clear();
+    setCells.clear();
+    usedStamps.clear();
+    downStamps.clear();
+
+    cellSets.shrink_to_fit();
+    setParents.shrink_to_fit();
+    setCells.shrink_to_fit();
+    usedStamps.shrink_to_fit();
+    downStamps.shrink_to_fit();
+}
+
+//Find representative label of set (with path halving)
+std::uint32_t MazeGeneratorEller::findSet(std::uint32_t set)
+{
+    while (setParents[set] != set)
+    {
+        setParents[set] = setParents[setParents[set]];
+        set = setParents[set];
+    }
+
+    return set;
+}
+
+//Give new sets to cells that are not connected to row above and reset union-find for new row
+//Labels are always smaller than count of cells, there is never more sets than cells
+void MazeGeneratorEller::assignSets(std::uint64_t cellRow)
+{
+    for (std::uint32_t set : cellSets)
+    {
+        if (set != NO_SET)
+        {
+            usedStamps[set] = cellRow + 1;
+        }
+    }
+
+    std::uint32_t freeSet = 0;
+
+    for (std::uint32_t& set : cellSets)
+    {
+        if (set == NO_SET)
+        {
+            while (usedStamps[freeSet] == cellRow + 1)
+            {
+                freeSet++;
+            }
+
+            set = freeSet++;
+        }
+    }
+
+    for (std::uint32_t set = 0; set < setParents.size(); set++)
+    {
+        setParents[set] = set;
+    }
+}
+
+//Pass row to sink or store it in maze array, exit is opened here because border rows are written only once
+void MazeGeneratorEller::writeRow(std::uint64_t row)
+{
+    if ((endBorder == Direction::TOP && row == 0) || (endBorder == Direction::BOTTOM && row == rowCount - 1))
+    {
+        rowWords[endX >> 6] &= ~(std::uint64_t(1) << (endX & 63));
+    }
+    else if (endBorder == Direction::LEFT && row == endY)
+    {
+        rowWords[0] &= ~std::uint64_t(1);
+    }
+    else if (endBorder == Direction::RIGHT && row == endY)
+    {
+        rowWords[(mazeSize - 1) >> 6] &= ~(std::uint64_t(1) << ((mazeSize - 1) & 63));
+    }
+
+    if (mazeSize % 64 != 0)
+    {
+        rowWords.back() &= (std::uint64_t(1) << (mazeSize % 64)) - 1;
+    }
+
+    if (rowSink)
+    {
+        rowSink(row, rowWords.data());
+    }
+    else if (storage)
+    {
+        for (std::uint64_t column = 0; column < mazeSize; column++)
+        {
+            storage->set(row, column, (rowWords[column >> 6] >> (column & 63)) & 1);
+        }
+    }
+    else
+    {
+        for (std::uint64_t i = 0; i < rowWords.size(); i++)
+        {
+            mazeArray.setBits(row, i * 64, rowWords[i]);
+        }
+    }
+}
+
+static MazeGeneratorRegistrar registrar("ELLER", "Eller's algorithm, maze is generated row by row", "", MazeGeneratorInfo::WALL_STORAGE | MazeGeneratorInfo::STREAMING, 65.0, 51.0, 0.0,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorEller(size, seed); });
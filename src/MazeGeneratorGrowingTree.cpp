@@ -0,0 +1,340 @@
+#include "MazeGeneratorGrowingTree.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+MazeGrowingTreeMixed::MazeGrowingTreeMixed(double newest, double oldest)
+{
+    newest = std::min(std::max(newest, 0.0), 1.0);
+    oldest = std::min(std::max(oldest, 0.0), 1.0 - newest);
+
+    newestLimit = std::uint64_t(newest * 4294967296.0);
+    oldestLimit = std::uint64_t((newest + oldest) * 4294967296.0);
+}
+
+template <typename Policy>
+MazeGeneratorGrowingTree<Policy>::MazeGeneratorGrowingTree(std::uint64_t size, std::string seed, Policy policy)
+: MazeGenerator(size, seed)
+{
+    mazeSize = size;
+
+    if (mazeSize % 2 == 0) //Cells are on odd indices and walls on even ones like in RD
+    {
+        mazeSize++;
+    }
+
+    this->policy = policy;
+    wallStorageSupported = true;
+}
+
+template <typename Policy>
+void MazeGeneratorGrowingTree<Policy>::generateMaze()
+{
+    allocateArray(false);
+
+    fillFields(true);
+
+    cellColumns = (mazeSize - 1) / 2;
+    cellRows = (mazeSize - 1) / 2;
+
+    //Buffer starts big enough for frontier of Prim-like mazes, DFS-like mazes double it a few times
+    std::uint64_t capacity = 1024;
+
+    while (capacity < (cellColumns + cellRows) * 2)
+    {
+        capacity *= 2;
+    }
+
+    activeCells.assign(capacity, 0);
+    activeStart = 0;
+    activeCount = 0;
+    removedCount = 0;
+    mazeCells.assign((cellColumns * cellRows + 63) / 64, 0);
+    peakStackSize = 0;
+
+    MazeRandom stream = getRandomStream(0);
+    MazeSequentialRandom random(stream);
+
+    addCell(random.getBounded32(cellRows), random.getBounded32(cellColumns));
+
+    std::uint64_t carvedCells = 1;
+    startProgress(cellColumns * cellRows);
+
+    while (activeCount > 0)
+    {
+        std::uint64_t index = policy.select(random, activeCount);
+
+        //Oldest and newest cell are never removed ones, so only random choice is repeated, which keeps it uniform over active cells
+        while (Policy::keepsOrder && getActive(index) == REMOVED_CELL)
+        {
+            index = random.getBounded32(activeCount);
+        }
+
+        std::uint64_t cellRow = getActive(index) >> 32;
+        std::uint64_t cellColumn = getActive(index) & 0xFFFFFFFF;
+
+        std::uint64_t neighbours[4][2];
+        unsigned int neighbourCount = 0;
+
+        if (cellRow > 0 && !isInMaze(cellRow - 1, cellColumn))
+        {
+            neighbours[neighbourCount][0] = cellRow - 1;
+            neighbours[neighbourCount++][1] = cellColumn;
+        }
+
+        if (cellRow + 1 < cellRows && !isInMaze(cellRow + 1, cellColumn))
+        {
+            neighbours[neighbourCount][0] = cellRow + 1;
+            neighbours[neighbourCount++][1] = cellColumn;
+        }
+
+        if (cellColumn > 0 && !isInMaze(cellRow, cellColumn - 1))
+        {
+            neighbours[neighbourCount][0] = cellRow;
+            neighbours[neighbourCount++][1] = cellColumn - 1;
+        }
+
+        if (cellColumn + 1 < cellColumns && !isInMaze(cellRow, cellColumn + 1))
+        {
+            neighbours[neighbourCount][0] = cellRow;
+            neighbours[neighbourCount++][1] = cellColumn + 1;
+        }
+
+        if (neighbourCount == 0)
+        {
+            removeActive(index);
+
+            continue;
+        }
+
+        unsigned int neighbour = neighbourCount > 1 ? random.getBounded32(neighbourCount) : 0;
+
+        //Wall between cells is in the middle of their fields
+        setField(cellRow + neighbours[neighbour][0] + 1, cellColumn + neighbours[neighbour][1] + 1, false);
+
+        addCell(neighbours[neighbour][0], neighbours[neighbour][1]);
+
+        if (++carvedCells % PROGRESS_STEP == 0)
+        {
+            setProgress(carvedCells);
+
+            if (isCancelled())
+            {
+                break;
+            }
+        }
+    }
+
+    activeCells.clear();
+    activeCells.shrink_to_fit();
+    mazeCells.clear();
+    mazeCells.shrink_to_fit();
+
+    if (isCancelled())
+    {
+        return;
+    }
+
+    setExit();
+    setStartPosition();
+}
+
+//Carve cell and add it as newest active cell
+template <typename Policy>
+void MazeGeneratorGrowingTree<Policy>::addCell(std::uint64_t cellRow, std::uint64_t cellColumn)
+{
+    std::uint64_t cell = cellRow * cellColumns + cellColumn;
+
+    mazeCells[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+    setField(cellRow * 2 + 1, cellColumn * 2 + 1, false);
+
+    if (activeCount == activeCells.size())
+    {
+        //Unroll full ring into twice bigger buffer without removed cells
+        std::vector<std::uint64_t> cells(activeCells.size() * 2);
+        std::uint64_t count = 0;
+
+        for (std::uint64_t i = 0; i < activeCount; i++)
+        {
+            if (getActive(i) != REMOVED_CELL)
+            {
+                cells[count++] = getActive(i);
+            }
+        }
+
+        activeCells.swap(cells);
+        activeStart = 0;
+        activeCount = count;
+        removedCount = 0;
+    }
+
+    getActive(activeCount++) = (cellRow << 32) | cellColumn;
+    peakStackSize = std::max<std::size_t>(peakStackSize, activeCount);
+}
+
+//Oldest and newest cells are removed from ends of ring, other cells are replaced by newest cell
+//Policies that keep age order mark other cells as removed instead and compact ring when half of it is removed
+template <typename Policy>
+void MazeGeneratorGrowingTree<Policy>::removeActive(std::uint64_t index)
+{
+    if (index == 0)
+    {
+        activeStart = (activeStart + 1) & (activeCells.size() - 1);
+        activeCount--;
+    }
+    else if (index + 1 == activeCount)
+    {
+        activeCount--;
+    }
+    else if (!Policy::keepsOrder)
+    {
+        getActive(index) = getActive(activeCount - 1);
+        activeCount--;
+    }
+    else
+    {
+        getActive(index) = REMOVED_CELL;
+        removedCount++;
+    }
+
+    if (!Policy::keepsOrder)
+    {
+        return;
+    }
+
+    //Ends of ring are always active cells
+    while (activeCount > 0 && getActive(0) == REMOVED_CELL)
+    {
+        activeStart = (activeStart + 1) & (activeCells.size() - 1);
+        activeCount--;
+        removedCount--;
+    }
+
+    while (activeCount > 0 && getActive(activeCount - 1) == REMOVED_CELL)
+    {
+        activeCount--;
+        removedCount--;
+    }
+
+    if (removedCount * 2 > activeCount)
+    {
+        std::uint64_t count = 0;
+
+        for (std::uint64_t i = 0; i < activeCount; i++)
+        {
+            if (getActive(i) != REMOVED_CELL)
+            {
+                getActive(count++) = getActive(i);
+            }
+        }
+
+        activeCount = count;
+        removedCount = 0;
+    }
+}
+
+template class MazeGeneratorGrowingTree<MazeGrowingTreeNewest>;
+template class MazeGeneratorGrowingTree<MazeGrowingTreeOldest>;
+template class MazeGeneratorGrowingTree<MazeGrowingTreeRandom>;
+template class MazeGeneratorGrowingTree<MazeGrowingTreeMixed>;
+
+MazeGenerator* createMazeGeneratorGrowingTree(std::uint64_t size, std::string seed, const std::string& policy)
+{
+    double newest = 0.0, oldest = 0.0, random = 0.0;
+    bool hasRandom = false;
+
+    std::stringstream policyStream(policy.empty() ? "newest" : policy);
+    std::string entry;
+
+    while (std::getline(policyStream, entry, ','))
+    {
+        std::size_t separator = entry.find('=');
+        std::string name = entry.substr(0, separator);
+        double weight = 1.0;
+
+        if (separator != std::string::npos)
+        {
+            try
+            {
+                weight = std::stod(entry.substr(separator + 1));
+            }
+            catch (...)
+            {
+                weight = -1.0;
+            }
+        }
+
+        //stod accepts nan and inf, which would make limits of mixed policy undefined
+        if (!std::isfinite(weight) || weight < 0.0)
+        {
+            std::cerr << "Invalid weight of growing tree policy: " << entry << std::endl;
+
+            return nullptr;
+        }
+
+        if (name == "newest")
+        {
+            newest += weight;
+        }
+        else if (name == "oldest")
+        {
+            oldest += weight;
+        }
+        else if (name == "random")
+        {
+            random += weight;
+            hasRandom = true;
+        }
+        else
+        {
+            std::cerr << "Unknown growing tree policy: " << name << std::endl;
+
+            return nullptr;
+        }
+    }
+
+    if (!hasRandom && newest + oldest < 1.0)
+    {
+        random = 1.0 - newest - oldest;
+    }
+
+    double total = newest + oldest + random;
+
+    if (!std::isfinite(total))
+    {
+        std::cerr << "Weights of growing tree policy are too big" << std::endl;
+
+        return nullptr;
+    }
+
+    if (total <= 0.0)
+    {
+        std::cerr << "Growing tree policy has no weight" << std::endl;
+
+        return nullptr;
+    }
+
+    //Single policy gets its own specialization without random choice of policy
+    if (newest == total)
+    {
+        return new MazeGeneratorGrowingTree<MazeGrowingTreeNewest>(size, seed);
+    }
+
+    if (oldest == total)
+    {
+        return new MazeGeneratorGrowingTree<MazeGrowingTreeOldest>(size, seed);
+    }
+
+    if (random == total)
+    {
+        return new MazeGeneratorGrowingTree<MazeGrowingTreeRandom>(size, seed);
+    }
+
+    return new MazeGeneratorGrowingTree<MazeGrowingTreeMixed>(size, seed, MazeGrowingTreeMixed(newest / total, oldest / total));
+}
+
+static MazeGeneratorRegistrar registrar("GT", "Growing tree, policy chooses between DFS-like and Prim-like mazes", "newest, oldest, random or weights like newest=0.5,oldest=0.25",
+    MazeGeneratorInfo::WALL_STORAGE, 72.0, 64.0, 0.7, createMazeGeneratorGrowingTree);
@@ -0,0 +1,257 @@
+#include "MazeGeneratorHuntAndKill.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+static unsigned int countTrailingZeros(std::uint64_t value)
+{
+    #if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+
+        return index;
+    #elif defined(_MSC_VER)
+        unsigned long index;
+
+        if (_BitScanForward(&index, unsigned(value)))
+        {
+            return index;
+        }
+
+        _BitScanForward(&index, unsigned(value >> 32));
+
+        return index + 32;
+    #else
+        return __builtin_ctzll(value);
+    #endif
+}
+
+MazeGeneratorHuntAndKill::MazeGeneratorHuntAndKill(std::uint64_t size, std::string seed)
+: MazeGenerator(size, seed)
+{
+    mazeSize = size;
+
+    if (mazeSize % 2 == 0) //Cells are on odd indices and walls on even ones like in RD
+    {
+        mazeSize++;
+    }
+
+    wallStorageSupported = true;
+}
+
+void MazeGeneratorHuntAndKill::generateMaze()
+{
+    allocateArray(false);
+
+    fillFields(true);
+
+    cellColumns = (mazeSize - 1) / 2;
+    cellRows = (mazeSize - 1) / 2;
+    rowWords = (cellColumns + 63) / 64;
+    huntWord = 0;
+
+    visitedCells.assign(rowWords * cellRows, 0);
+
+    MazeRandom stream = getRandomStream(0);
+    MazeSequentialRandom random(stream);
+
+    std::uint64_t cellRow = random.getBounded32(cellRows);
+    std::uint64_t cellColumn = random.getBounded32(cellColumns);
+
+    visit(cellRow, cellColumn);
+
+    std::uint64_t visitedCount = 1, reportedCount = 0;
+    startProgress(cellColumns * cellRows);
+
+    do
+    {
+        //Kill: walk to random unvisited neighbour until there is none
+        while (true)
+        {
+            std::uint64_t moves[4][2];
+            unsigned int moveCount = 0;
+
+            if (cellRow > 0 && !isVisited(cellRow - 1, cellColumn))
+            {
+                moves[moveCount][0] = cellRow - 1;
+                moves[moveCount++][1] = cellColumn;
+            }
+
+            if (cellRow + 1 < cellRows && !isVisited(cellRow + 1, cellColumn))
+            {
+                moves[moveCount][0] = cellRow + 1;
+                moves[moveCount++][1] = cellColumn;
+            }
+
+            if (cellColumn > 0 && !isVisited(cellRow, cellColumn - 1))
+            {
+                moves[moveCount][0] = cellRow;
+                moves[moveCount++][1] = cellColumn - 1;
+            }
+
+            if (cellColumn + 1 < cellColumns && !isVisited(cellRow, cellColumn + 1))
+            {
+                moves[moveCount][0] = cellRow;
+                moves[moveCount++][1] = cellColumn + 1;
+            }
+
+            if (moveCount == 0)
+            {
+                break;
+            }
+
+            unsigned int move = moveCount > 1 ? random.getBounded32(moveCount) : 0;
+
+            //Wall between cells is in the middle of their fields
+            setField(cellRow + moves[move][0] + 1, cellColumn + moves[move][1] + 1, false);
+
+            cellRow = moves[move][0];
+            cellColumn = moves[move][1];
+
+            visit(cellRow, cellColumn);
+            visitedCount++;
+        }
+
+        //Progress is checked between kill walks, so it doesn't slow down walking
+        if (visitedCount - reportedCount >= PROGRESS_STEP)
+        {
+            setProgress(visitedCount);
+            reportedCount = visitedCount;
+
+            if (isCancelled())
+            {
+                break;
+            }
+        }
+
+        //Hunt found cell next to maze, it's joined to random visited neighbour
+        if (hunt(cellRow, cellColumn))
+        {
+            std::uint64_t walls[4][2];
+            unsigned int wallCount = 0;
+
+            if (cellRow > 0 && isVisited(cellRow - 1, cellColumn))
+            {
+                walls[wallCount][0] = cellRow * 2;
+                walls[wallCount++][1] = cellColumn * 2 + 1;
+            }
+
+            if (cellRow + 1 < cellRows && isVisited(cellRow + 1, cellColumn))
+            {
+                walls[wallCount][0] = cellRow * 2 + 2;
+                walls[wallCount++][1] = cellColumn * 2 + 1;
+            }
+
+            if (cellColumn > 0 && isVisited(cellRow, cellColumn - 1))
+            {
+                walls[wallCount][0] = cellRow * 2 + 1;
+                walls[wallCount++][1] = cellColumn * 2;
+            }
+
+            if (cellColumn + 1 < cellColumns && isVisited(cellRow, cellColumn + 1))
+            {
+                walls[wallCount][0] = cellRow * 2 + 1;
+                walls[wallCount++][1] = cellColumn * 2 + 2;
+            }
+
+            unsigned int wall = wallCount > 1 ? random.getBounded32(wallCount) : 0;
+            setField(walls[wall][0], walls[wall][1], false);
+
+            visit(cellRow, cellColumn);
+            visitedCount++;
+        }
+        else
+        {
+            break;
+        }
+    } while (true);
+
+    visitedCells.clear();
+    visitedCells.shrink_to_fit();
+
+    if (isCancelled())
+    {
+        return;
+    }
+
+    setExit();
+    setStartPosition();
+}
+
+void MazeGeneratorHuntAndKill::visit(std::uint64_t cellRow, std::uint64_t cellColumn)
+{
+    visitedCells[cellRow * rowWords + (cellColumn >> 6)] |= std::uint64_t(1) << (cellColumn & 63);
+    setField(cellRow * 2 + 1, cellColumn * 2 + 1, false);
+}
+
+//Find first unvisited cell that has visited neighbour, returns false when all cells are visited
+//Candidates of 64 cells are unvisited bits masked by visited bits of row above, row below and row itself shifted by one cell
+bool MazeGeneratorHuntAndKill::hunt(std::uint64_t& cellRow, std::uint64_t& cellColumn)
+{
+    //Bits after last column are 0, so they have to be masked out of unvisited cells
+    std::uint64_t lastMask = cellColumns % 64 == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (cellColumns % 64)) - 1;
+    bool wordsVisited = true;
+
+    for (std::uint64_t row = huntWord / rowWords; row < cellRows; row++)
+    {
+        const std::uint64_t* words = &visitedCells[row * rowWords];
+        const std::uint64_t* above = row > 0 ? words - rowWords : nullptr;
+        const std::uint64_t* below = row + 1 < cellRows ? words + rowWords : nullptr;
+
+        for (std::uint64_t word = row == huntWord / rowWords ? huntWord % rowWords : 0; word < rowWords; word++)
+        {
+            std::uint64_t unvisited = ~words[word] & (word + 1 < rowWords ? ~std::uint64_t(0) : lastMask);
+
+            if (unvisited == 0)
+            {
+                continue;
+            }
+
+            //Words before this one are full, next hunt can start here
+            if (wordsVisited)
+            {
+                huntWord = row * rowWords + word;
+                wordsVisited = false;
+            }
+
+            std::uint64_t neighbours = (words[word] << 1) | (words[word] >> 1);
+
+            if (word > 0)
+            {
+                neighbours |= words[word - 1] >> 63;
+            }
+
+            if (word + 1 < rowWords)
+            {
+                neighbours |= words[word + 1] << 63;
+            }
+
+            if (above)
+            {
+                neighbours |= above[word];
+            }
+
+            if (below)
+            {
+                neighbours |= below[word];
+            }
+
+            std::uint64_t candidates = unvisited & neighbours;
+
+            if (candidates != 0)
+            {
+                cellRow = row;
+                cellColumn = word * 64 + countTrailingZeros(candidates);
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static MazeGeneratorRegistrar registrar("HUNTANDKILL", "Hunt-and-kill, long corridors like DFS without stack", "", MazeGeneratorInfo::WALL_STORAGE, 106.0, 94.0, 1.0 / 32.0,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorHuntAndKill(size, seed); });
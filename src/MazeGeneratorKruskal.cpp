@@ -0,0 +1,368 @@
+#include "MazeGeneratorKruskal.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+//Tile fields are local, row and column are relative to tile
+static void clearField(std::vector<std::uint64_t>& fields, std::uint32_t row, std::uint32_t column, std::uint32_t rowWords)
+{
+    fields[row * rowWords + (column >> 6)] &= ~(std::uint64_t(1) << (column & 63));
+}
+
+MazeGeneratorKruskal::MazeGeneratorKruskal(std::uint64_t size, std::string seed)
+: MazeGenerator(size, seed)
+{
+    mazeSize = size;
+
+    if (mazeSize % 2 == 0) //Cells are on odd indices and walls on even ones like in RD
+    {
+        mazeSize++;
+    }
+
+    wallStorageSupported = true;
+    parallelSupported = true;
+}
+
+void MazeGeneratorKruskal::generateMaze()
+{
+    cellColumns = (mazeSize - 1) / 2;
+    cellRows = (mazeSize - 1) / 2;
+
+    //Union-find keeps sizes of sets in 31 bits
+    if (cellColumns * cellRows >= 0x80000000)
+    {
+        std::cerr << "Maze is too big for Kruskal generator" << std::endl;
+        return;
+    }
+
+    allocateArray(false);
+
+    fillFields(true);
+
+    cells.reset(cellColumns * cellRows);
+
+    if (threadCount > 0)
+    {
+        generateParallel();
+    }
+    else
+    {
+        generateSerial();
+    }
+
+    cells.release();
+
+    if (isCancelled())
+    {
+        return;
+    }
+
+    setExit();
+    setStartPosition();
+}
+
+bool MazeGeneratorKruskal::mergeWall(std::uint64_t wall)
+{
+    std::uint64_t cell = wall >> 1;
+    std::uint64_t neighbour = wall & 1 ? cell + cellColumns : cell + 1;
+
+    if (!cells.unite(cell, neighbour))
+    {
+        return false;
+    }
+
+    std::uint64_t row = (cell / cellColumns) * 2 + 1;
+    std::uint64_t column = (cell % cellColumns) * 2 + 1;
+
+    if (wall & 1)
+    {
+        setField(row + 1, column, false);
+    }
+    else
+    {
+        setField(row, column + 1, false);
+    }
+
+    return true;
+}
+
+//Shuffle all interior walls and remove every wall that joins two different sets
+//Walls are shuffled while they are processed (Fisher-Yates from the end), so every wall is touched only once
+void MazeGeneratorKruskal::generateSerial()
+{
+    //Wall count is below 2^32 because cells are below 2^31
+    std::vector<std::uint32_t> walls;
+    walls.reserve(cellColumns * cellRows * 2);
+
+    for (std::uint64_t row = 0; row < cellRows; row++)
+    {
+        for (std::uint64_t column = 0; column < cellColumns; column++)
+        {
+            std::uint32_t cell = row * cellColumns + column;
+
+            if (column + 1 < cellColumns)
+            {
+                walls.push_back(cell * 2);
+            }
+
+            if (row + 1 < cellRows)
+            {
+                walls.push_back(cell * 2 + 1);
+            }
+
+            setField(row * 2 + 1, column * 2 + 1, false);
+        }
+    }
+
+    MazeRandom stream = getRandomStream(0);
+    MazeSequentialRandom random(stream);
+
+    //Spanning tree is complete after cells - 1 joins, rest of walls would only be rejected
+    std::uint64_t joinsLeft = cellColumns * cellRows - 1;
+
+    startProgress(joinsLeft);
+
+    for (std::size_t remaining = walls.size(); remaining > 0 && joinsLeft > 0; remaining--)
+    {
+        std::swap(walls[remaining - 1], walls[random.getBounded32(remaining)]);
+
+        if (mergeWall(walls[remaining - 1]) && --joinsLeft % PROGRESS_STEP == 0)
+        {
+            setProgress(cellColumns * cellRows - 1 - joinsLeft);
+
+            if (isCancelled())
+            {
+                return;
+            }
+        }
+    }
+}
+
+void MazeGeneratorKruskal::generateParallel()
+{
+    tileColumns = (cellColumns + TILE_CELLS - 1) / TILE_CELLS;
+    tileRows = (cellRows + TILE_CELLS - 1) / TILE_CELLS;
+
+    std::uint64_t tileCount = tileColumns * tileRows;
+
+    //Tiles don't share words or cells, so they can be written by more threads without atomic operations
+    unsigned int threads = std::max(1u, std::min<unsigned int>(threadCount, tileCount));
+    std::atomic<std::uint64_t> nextTile(0);
+    std::vector<std::vector<std::uint64_t>> tileWalls(tileCount); //Walls of tile that weren't merged or filtered
+
+    //Tiles and merging of tiles are parts of work
+    startProgress(tileCount + 1);
+
+    auto processTiles = [this, &nextTile, &tileWalls, tileCount]()
+    {
+        TileWork work;
+
+        for (std::uint64_t tile = nextTile++; tile < tileCount && !isCancelled(); tile = nextTile++)
+        {
+            mergeTile(tile, work, tileWalls[tile]);
+            addProgress(1);
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    for (unsigned int i = 1; i < threads; i++)
+    {
+        workers.emplace_back(processTiles);
+    }
+
+    processTiles();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (isCancelled())
+    {
+        return;
+    }
+
+    mergeTiles(tileWalls);
+    addProgress(1);
+}
+
+//Shuffle walls inside of tile and remove first half of them if they join two different sets, then keep only remaining walls that still join two sets
+//Every tile ends as forest of cell sets, trees are joined with each other and with other tiles by mergeTiles
+//Fields of tile are carved in local bit array and written to maze array as whole words at the end
+void MazeGeneratorKruskal::mergeTile(std::uint64_t tile, TileWork& work, std::vector<std::uint64_t>& remainingWalls)
+{
+    static const std::uint64_t TILE_WORDS = TILE_CELLS * 2 / 64; //Words in one row of tile fields
+
+    std::uint64_t startColumn = (tile % tileColumns) * TILE_CELLS;
+    std::uint64_t startRow = (tile / tileColumns) * TILE_CELLS;
+    std::uint32_t width = std::min<std::uint64_t>(TILE_CELLS, cellColumns - startColumn);
+    std::uint32_t height = std::min<std::uint64_t>(TILE_CELLS, cellRows - startRow);
+
+    //Cell index is row * TILE_CELLS + column even in smaller tiles on maze border
+    //Wall is cell index * 2 (wall right of cell) or cell index * 2 + 1 (wall below cell)
+    work.walls.clear();
+    work.fields.assign(TILE_CELLS * 2 * TILE_WORDS, ~std::uint64_t(0));
+
+    for (std::uint32_t row = 0; row < height; row++)
+    {
+        for (std::uint32_t column = 0; column < width; column++)
+        {
+            std::uint32_t cell = row * TILE_CELLS + column;
+
+            if (column + 1 < width)
+            {
+                work.walls.push_back(cell * 2);
+            }
+
+            if (row + 1 < height)
+            {
+                work.walls.push_back(cell * 2 + 1);
+            }
+
+            clearField(work.fields, row * 2 + 1, column * 2 + 1, TILE_WORDS);
+        }
+    }
+
+    MazeRandom tileStream = getRandomStream(tile);
+    MazeSequentialRandom random(tileStream);
+
+    auto getGlobalCell = [this, startRow, startColumn](std::uint32_t cell)
+    {
+        return (startRow + cell / TILE_CELLS) * cellColumns + startColumn + cell % TILE_CELLS;
+    };
+
+    std::size_t remaining = work.walls.size();
+
+    for (std::size_t merged = 0; merged < work.walls.size() / 2; merged++, remaining--)
+    {
+        std::swap(work.walls[remaining - 1], work.walls[random.getBounded32(remaining)]);
+
+        std::uint32_t wall = work.walls[remaining - 1];
+        std::uint32_t cell = wall >> 1;
+        std::uint32_t neighbour = wall & 1 ? cell + TILE_CELLS : cell + 1;
+
+        if (cells.unite(getGlobalCell(cell), getGlobalCell(neighbour)))
+        {
+            std::uint32_t row = (cell / TILE_CELLS) * 2 + 1;
+            std::uint32_t column = (cell % TILE_CELLS) * 2 + 1;
+
+            if (wall & 1)
+            {
+                clearField(work.fields, row + 1, column, TILE_WORDS);
+            }
+            else
+            {
+                clearField(work.fields, row, column + 1, TILE_WORDS);
+            }
+        }
+    }
+
+    //Filter, wall between cells of one set would be rejected by mergeTiles anyway
+    remainingWalls.clear();
+
+    for (std::size_t i = 0; i < remaining; i++)
+    {
+        std::uint32_t wall = work.walls[i];
+        std::uint32_t cell = wall >> 1;
+        std::uint32_t neighbour = wall & 1 ? cell + TILE_CELLS : cell + 1;
+
+        if (cells.find(getGlobalCell(cell)) != cells.find(getGlobalCell(neighbour)))
+        {
+            remainingWalls.push_back(getGlobalCell(cell) * 2 + (wall & 1));
+        }
+    }
+
+    remainingWalls.shrink_to_fit();
+
+    //Tile fields start at word boundary, first row and column are border walls of tile above and left (they stay walls here)
+    std::uint64_t firstRow = startRow * 2;
+    std::uint64_t firstColumn = startColumn * 2;
+    std::uint64_t fieldRows = std::min<std::uint64_t>(TILE_CELLS * 2, mazeSize - firstRow);
+    std::uint64_t fieldColumns = std::min<std::uint64_t>(TILE_CELLS * 2, mazeSize - firstColumn);
+
+    for (std::uint64_t row = 0; row < fieldRows; row++)
+    {
+        const std::uint64_t* words = &work.fields[row * TILE_WORDS];
+
+        if (storage)
+        {
+            for (std::uint64_t column = 0; column < fieldColumns; column++)
+            {
+                storage->set(firstRow + row, firstColumn + column, (words[column >> 6] >> (column & 63)) & 1);
+            }
+        }
+        else
+        {
+            for (std::uint64_t word = 0; word < (fieldColumns + 63) / 64; word++)
+            {
+                mazeArray.setBits(firstRow + row, firstColumn + word * 64, words[word]);
+            }
+        }
+    }
+}
+
+//Merge walls between tiles and walls left by tiles with cell sets
+//Walls between tiles come after first half of walls inside of tiles, so more of them (5/6) are merged before the rest to open them
+//as often as walls inside of tiles (measured share of removed walls is 0.50 for both), rest is shuffled together with remaining walls of tiles
+void MazeGeneratorKruskal::mergeTiles(std::vector<std::vector<std::uint64_t>>& tileWalls)
+{
+    std::vector<std::uint64_t> walls;
+
+    for (std::uint64_t row = 0; row < cellRows; row++)
+    {
+        for (std::uint64_t column = TILE_CELLS - 1; column + 1 < cellColumns; column += TILE_CELLS)
+        {
+            walls.push_back((row * cellColumns + column) * 2);
+        }
+    }
+
+    for (std::uint64_t row = TILE_CELLS - 1; row + 1 < cellRows; row += TILE_CELLS)
+    {
+        for (std::uint64_t column = 0; column < cellColumns; column++)
+        {
+            walls.push_back((row * cellColumns + column) * 2 + 1);
+        }
+    }
+
+    //Stream after all tile streams
+    MazeRandom stream = getRandomStream(tileColumns * tileRows);
+    MazeSequentialRandom random(stream);
+
+    std::size_t borderWalls = walls.size();
+    std::size_t remaining = walls.size();
+
+    for (; remaining > borderWalls / 6; remaining--)
+    {
+        std::swap(walls[remaining - 1], walls[random.getBounded32(remaining)]);
+
+        mergeWall(walls[remaining - 1]);
+    }
+
+    walls.resize(remaining);
+
+    for (std::vector<std::uint64_t>& remainingWalls : tileWalls)
+    {
+        walls.insert(walls.end(), remainingWalls.begin(), remainingWalls.end());
+
+        std::vector<std::uint64_t>().swap(remainingWalls);
+    }
+
+    for (remaining = walls.size(); remaining > 0; remaining--)
+    {
+        std::swap(walls[remaining - 1], walls[random.getBounded32(remaining)]);
+
+        mergeWall(walls[remaining - 1]);
+
+        if (remaining % PROGRESS_STEP == 0 && isCancelled())
+        {
+            return;
+        }
+    }
+}
+
+static MazeGeneratorRegistrar registrar("KRUSKAL", "Kruskal's algorithm, short dead ends", "", MazeGeneratorInfo::PARALLEL | MazeGeneratorInfo::WALL_STORAGE, 11.0, 9.0, 3.0,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorKruskal(size, seed); });
@@ -0,0 +1,162 @@
+#include "MazeGeneratorPrim.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+#include <algorithm>
+
+MazeGeneratorPrim::MazeGeneratorPrim(std::uint64_t size, std::string seed)
+: MazeGenerator(size, seed)
+{
+    mazeSize = size;
+
+    if (mazeSize % 2 == 0) //Cells are on odd indices and walls on even ones like in RD
+    {
+        mazeSize++;
+    }
+
+    wallStorageSupported = true;
+}
+
+void MazeGeneratorPrim::generateMaze()
+{
+    allocateArray(false);
+
+    fillFields(true);
+
+    cellColumns = (mazeSize - 1) / 2;
+    cellRows = (mazeSize - 1) / 2;
+
+    std::uint64_t cellCount = cellColumns * cellRows;
+
+    frontier.clear();
+    frontierCells.assign((cellCount + 63) / 64, 0);
+    mazeCells.assign((cellCount + 63) / 64, 0);
+    peakStackSize = 0;
+
+    MazeRandom stream = getRandomStream(0);
+    MazeSequentialRandom random(stream);
+
+    addToMaze(random.getBounded32(cellRows), random.getBounded32(cellColumns));
+
+    std::uint64_t joinedCells = 1;
+    startProgress(cellCount);
+
+    while (!frontier.empty())
+    {
+        //Take random frontier cell, last cell is moved to its place
+        std::size_t index = random.getBounded32(frontier.size());
+        std::uint64_t cellRow = frontier[index] >> 32;
+        std::uint64_t cellColumn = frontier[index] & 0xFFFFFFFF;
+        std::uint64_t cell = cellRow * cellColumns + cellColumn;
+
+        frontier[index] = frontier.back();
+        frontier.pop_back();
+        frontierCells[cell >> 6] &= ~(std::uint64_t(1) << (cell & 63));
+
+        //Join it to random neighbour that is already in maze
+        std::uint64_t walls[4][2];
+        unsigned int wallCount = 0;
+
+        if (cellRow > 0 && isInMaze(cellRow - 1, cellColumn))
+        {
+            walls[wallCount][0] = cellRow * 2;
+            walls[wallCount++][1] = cellColumn * 2 + 1;
+        }
+
+        if (cellRow + 1 < cellRows && isInMaze(cellRow + 1, cellColumn))
+        {
+            walls[wallCount][0] = cellRow * 2 + 2;
+            walls[wallCount++][1] = cellColumn * 2 + 1;
+        }
+
+        if (cellColumn > 0 && isInMaze(cellRow, cellColumn - 1))
+        {
+            walls[wallCount][0] = cellRow * 2 + 1;
+            walls[wallCount++][1] = cellColumn * 2;
+        }
+
+        if (cellColumn + 1 < cellColumns && isInMaze(cellRow, cellColumn + 1))
+        {
+            walls[wallCount][0] = cellRow * 2 + 1;
+            walls[wallCount++][1] = cellColumn * 2 + 2;
+        }
+
+        unsigned int wall = wallCount > 1 ? random.getBounded32(wallCount) : 0;
+        setField(walls[wall][0], walls[wall][1], false);
+
+        addToMaze(cellRow, cellColumn);
+
+        if (++joinedCells % PROGRESS_STEP == 0)
+        {
+            setProgress(joinedCells);
+
+            if (isCancelled())
+            {
+                break;
+            }
+        }
+    }
+
+    frontier.clear();
+    frontier.shrink_to_fit();
+    frontierCells.clear();
+    frontierCells.shrink_to_fit();
+    mazeCells.clear();
+    mazeCells.shrink_to_fit();
+
+    if (isCancelled())
+    {
+        return;
+    }
+
+    setExit();
+    setStartPosition();
+}
+
+//Carve cell and add its neighbours that are not in maze or frontier to frontier
+void MazeGeneratorPrim::addToMaze(std::uint64_t cellRow, std::uint64_t cellColumn)
+{
+    std::uint64_t cell = cellRow * cellColumns + cellColumn;
+
+    mazeCells[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+    setField(cellRow * 2 + 1, cellColumn * 2 + 1, false);
+
+    if (cellRow > 0)
+    {
+        addToFrontier(cellRow - 1, cellColumn);
+    }
+
+    if (cellRow + 1 < cellRows)
+    {
+        addToFrontier(cellRow + 1, cellColumn);
+    }
+
+    if (cellColumn > 0)
+    {
+        addToFrontier(cellRow, cellColumn - 1);
+    }
+
+    if (cellColumn + 1 < cellColumns)
+    {
+        addToFrontier(cellRow, cellColumn + 1);
+    }
+
+    peakStackSize = std::max(peakStackSize, frontier.size());
+}
+
+void MazeGeneratorPrim::addToFrontier(std::uint64_t cellRow, std::uint64_t cellColumn)
+{
+    std::uint64_t cell = cellRow * cellColumns + cellColumn;
+    std::uint64_t& word = frontierCells[cell >> 6];
+    std::uint64_t bit = std::uint64_t(1) << (cell & 63);
+
+    if ((word & bit) || isInMaze(cellRow, cellColumn))
+    {
+        return;
+    }
+
+    word |= bit;
+    frontier.push_back((cellRow << 32) | cellColumn);
+}
+
+static MazeGeneratorRegistrar registrar("PRIM", "Prim's algorithm, many short dead ends", "", MazeGeneratorInfo::WALL_STORAGE, 42.0, 36.0, 1.0 / 16.0,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorPrim(size, seed); });
@@ -1,8 +1,11 @@
 #include "MazeGeneratorRD.hpp"
+#include "MazeGeneratorRegistry.hpp"
+#include "MazeTaskPool.hpp"
 
+#include <algorithm>
 #include <iostream>
 
-MazeGeneratorRD::MazeGeneratorRD(unsigned int size, std::string seed)
+MazeGeneratorRD::MazeGeneratorRD(std::uint64_t size, std::string seed)
 : MazeGenerator(size, seed)
 {
     mazeSize = size;
@@ -12,112 +15,363 @@ MazeGeneratorRD::MazeGeneratorRD(unsigned int size, std::string seed)
         mazeSize++;
     }
 
-    allocateArray();
+    wallStorageSupported = true; //Walls are always on even indices
+    parallelSupported = true;
 }
 
-void MazeGeneratorRD::allocateArray()
+void MazeGeneratorRD::generateMaze()
 {
-    mazeArray = new bool*[mazeSize];
-    
-    for(unsigned int i = 0; i < mazeSize; ++i)
-        mazeArray[i] = new bool[mazeSize];
+    stepState = StepState::STARTING;
+
+    step(~std::uint64_t(0));
 }
 
-void MazeGeneratorRD::generateMaze()
+//Every unit of budget is one chamber taken from work stack
+//Parallel division isn't resumable, it's done in the first step (array is also filled in the first step)
+bool MazeGeneratorRD::step(std::uint64_t budget)
 {
-    //Init array
-    for (unsigned int i = 0; i < mazeSize; i++)
+    if (stepState == StepState::FINISHED)
+    {
+        return true;
+    }
+
+    bool parallel = threadCount > 0 && !storage;
+
+    if (stepState == StepState::STARTING)
     {
-        for (unsigned int j = 0; j < mazeSize; j++)
+        //Array is filled here, so allocation doesn't clear it first
+        allocateArray(false);
+        fillFields(false);
+
+        //Make border
+        for (std::uint64_t i = 0; i < mazeSize; i++)
+        {
+            setField(i, 0, true); //Left
+            setField(0, i, true); //Top
+            setField(i, mazeSize - 1, true); //Right
+            setField(mazeSize - 1, i, true); //Bottom
+        }
+
+        //Get count of maze fields in allocated array
+        //Maze fields are array fields with odd index
+        std::int64_t mazeFields = (mazeSize - 1) / 2;
+
+        //Progress is count of cells in chambers that are too small to be divided
+        startProgress(mazeFields * mazeFields);
+
+        if (parallel)
+        {
+            divideChambersParallel(mazeFields);
+        }
+        else
         {
-            mazeArray[i][j] = false;
+            chamberStack.clear();
+            verticalWalls.clear();
+            chamberStack.push_back({ 0, 0, mazeFields - 1, mazeFields - 1, mazeFields - 1 });
+            peakStackSize = 1;
+            divisionCount = 0;
+            finishedCellCount = 0;
         }
+
+        stepState = StepState::RUNNING;
     }
 
-    //Make border
-    for (unsigned int i = 0; i < mazeSize; i++)
+    if (!parallel && !divideChambers(budget))
     {
-        mazeArray[i][0] = true; //Left
-        mazeArray[0][i] = true; //Top
-        mazeArray[i][mazeSize - 1] = true; //Right
-        mazeArray[mazeSize - 1][i] = true; //Bottom
+        return false;
     }
 
-    //Get count of maze fields in allocated array
-    //Maze fields are array fields with odd index
-    int mazeFields = (mazeSize - 1) / 2;
+    stepState = StepState::FINISHED;
 
-    divideChamber(0, 0, mazeFields - 1, mazeFields - 1, Orientation(getRandomNumber(0, 1)));
+    if (!isCancelled())
+    {
+        setExit();
+        setStartPosition();
+    }
 
-    setExit();
-    setStartPosition();
+    return true;
 }
 
-//Divide chamber into two chambers
-//After dividing run this function again for each chamber
-void MazeGeneratorRD::divideChamber(int startFieldX, int startFieldY, int endFieldX, int endFieldY, Orientation direction)
+//Divide chamber into two chambers, then divide each of them the same way until chambers are too small, returns true when all chambers are divided
+//Second chamber is pushed first, so whole first chamber is divided before second one (random numbers are used in the same order as in recursive version)
+bool MazeGeneratorRD::divideChambers(std::uint64_t budget)
 {
-    if ((endFieldX - startFieldX) < 1 || (endFieldY - startFieldY) < 1)
+    for (; budget > 0 && !chamberStack.empty(); budget--)
+    {
+        Chamber chamber = chamberStack.back();
+        chamberStack.pop_back();
+
+        //Orientation is chosen before size check, it can use random number even for chamber that won't be divided
+        Orientation direction = setOrientation(chamber.orientationWidth, chamber.endFieldY - chamber.startFieldY);
+
+        if ((chamber.endFieldX - chamber.startFieldX) < 1 || (chamber.endFieldY - chamber.startFieldY) < 1)
+        {
+            finishedCellCount += (chamber.endFieldX - chamber.startFieldX + 1) * (chamber.endFieldY - chamber.startFieldY + 1);
+
+            continue;
+        }
+
+        //Draw horizontal wall
+        if (direction == Orientation::HORIZONTAL)
+        {
+            std::int64_t wallField = getRandomNumber(chamber.startFieldY, chamber.endFieldY - 1);
+
+            //Get array index of randomly selected maze field
+            std::int64_t wallIndex = wallField * 2 + 1;
+            wallIndex++; //Wall will be drawn in position next to the selected field
+
+            fillRowFields(wallIndex, chamber.startFieldX * 2 + 1, chamber.endFieldX * 2 + 2, true); //Draw horizontal wall
+
+            std::int64_t passageField = getRandomNumber(chamber.startFieldX, chamber.endFieldX); //Select maze field where passage will be placed
+
+            setField(wallIndex, passageField * 2 + 1, false); //Put passage on wall
+
+            //There are two chambers divided by horizontal wall
+            std::int64_t width = chamber.endFieldX - chamber.startFieldX;
+
+            chamberStack.push_back({ chamber.startFieldX, wallField + 1, chamber.endFieldX, chamber.endFieldY, width });
+            chamberStack.push_back({ chamber.startFieldX, chamber.startFieldY, chamber.endFieldX, wallField, width });
+        }
+        else //Drawing vertical wall
+        {
+            std::int64_t wallField = getRandomNumber(chamber.startFieldX, chamber.endFieldX - 1);
+
+            //Same as before but vertically
+            std::int64_t wallIndex = wallField * 2 + 1;
+            wallIndex++;
+
+            std::int64_t passageField = getRandomNumber(chamber.startFieldY, chamber.endFieldY);
+
+            //Short walls stay in cache, only walls longer than band of rows are buffered
+            if (std::uint64_t(chamber.endFieldY - chamber.startFieldY) * 2 + 1 < WALL_BAND_ROWS)
+            {
+                fillColumnFields(wallIndex, chamber.startFieldY * 2 + 1, chamber.endFieldY * 2 + 2, true);
+                setField(passageField * 2 + 1, wallIndex, false);
+            }
+            else
+            {
+                verticalWalls.push_back({ std::uint64_t(wallIndex), std::uint64_t(chamber.startFieldY * 2 + 1), std::uint64_t(chamber.endFieldY * 2 + 2),
+                                          std::uint64_t(passageField * 2 + 1) });
+
+                if (verticalWalls.size() == VERTICAL_WALL_BUFFER)
+                {
+                    flushVerticalWalls();
+                }
+            }
+
+            //Both chambers use width of the first one for orientation
+            std::int64_t width = wallField - chamber.startFieldX;
+
+            chamberStack.push_back({ wallField + 1, chamber.startFieldY, chamber.endFieldX, chamber.endFieldY, width });
+            chamberStack.push_back({ chamber.startFieldX, chamber.startFieldY, wallField, chamber.endFieldY, width });
+        }
+
+        peakStackSize = std::max(peakStackSize, chamberStack.size());
+
+        if (++divisionCount % PROGRESS_STEP == 0)
+        {
+            setProgress(finishedCellCount);
+
+            if (isCancelled())
+            {
+                chamberStack.clear();
+            }
+        }
+    }
+
+    //Array is complete after every step, so it can be read between steps
+    flushVerticalWalls();
+
+    if (!chamberStack.empty())
+    {
+        return false;
+    }
+
+    chamberStack.shrink_to_fit();
+    verticalWalls.shrink_to_fit();
+    activeWalls.shrink_to_fit();
+
+    return true;
+}
+
+//Write buffered vertical walls band by band, walls crossing band are active and they are written from left to right
+void MazeGeneratorRD::flushVerticalWalls()
+{
+    if (verticalWalls.empty())
     {
         return;
     }
 
-    //Draw horizontal wall
-    if (direction == Orientation::HORIZONTAL)
+    std::sort(verticalWalls.begin(), verticalWalls.end(), [](const VerticalWall& first, const VerticalWall& second) {
+        return first.startRow < second.startRow;
+    });
+
+    std::uint64_t endRow = 0;
+
+    for (const VerticalWall& wall : verticalWalls)
     {
-        int wallField = getRandomNumber(startFieldY, endFieldY - 1);
+        endRow = std::max(endRow, wall.endRow);
+    }
+
+    std::size_t nextWall = 0;
+    activeWalls.clear();
 
-        //Get array index of randomly selected maze field
-        int wallIndex = wallField * 2 + 1;
-        wallIndex++; //Wall will be drawn in position next to the selected field
+    for (std::uint64_t bandRow = verticalWalls[0].startRow; bandRow < endRow; bandRow += WALL_BAND_ROWS)
+    {
+        activeWalls.erase(std::remove_if(activeWalls.begin(), activeWalls.end(), [bandRow](const VerticalWall& wall) {
+            return wall.endRow <= bandRow;
+        }), activeWalls.end());
 
-        for (int i = startFieldX * 2 + 1; i < endFieldX * 2 + 2; i++) //Draw horizontal wall
+        //Skip rows without walls
+        if (activeWalls.empty())
         {
-            mazeArray[wallIndex][i] = true;
+            bandRow = std::max(bandRow, verticalWalls[nextWall].startRow);
         }
 
-        int passageField = getRandomNumber(startFieldX, endFieldX); //Select maze field where passage will be placed
+        std::uint64_t bandEndRow = std::min(bandRow + WALL_BAND_ROWS, endRow);
+
+        while (nextWall < verticalWalls.size() && verticalWalls[nextWall].startRow < bandEndRow)
+        {
+            activeWalls.push_back(verticalWalls[nextWall++]);
+        }
 
-        mazeArray[wallIndex][passageField * 2 + 1] = false; //Put passage on wall
+        std::sort(activeWalls.begin(), activeWalls.end(), [](const VerticalWall& first, const VerticalWall& second) {
+            return first.column < second.column;
+        });
 
-        //There are two chambers divided by horizontal wall
-        
-        //Divide created chambers
-        divideChamber(startFieldX, startFieldY, endFieldX, wallField, setOrientation(startFieldX, startFieldY, endFieldX, wallField));
-        divideChamber(startFieldX, wallField + 1, endFieldX, endFieldY, setOrientation(startFieldX, wallField + 1, endFieldX, endFieldY));
+        //Walls are written from left to right, band of rows is small enough to stay in cache while it's written
+        for (const VerticalWall& wall : activeWalls)
+        {
+            for (std::uint64_t row = std::max(bandRow, wall.startRow); row < std::min(bandEndRow, wall.endRow); row++)
+            {
+                if (row == wall.passageRow)
+                {
+                    continue;
+                }
+
+                if (storage)
+                {
+                    storage->set(row, wall.column, true);
+                }
+                else
+                {
+                    mazeArray.set(row, wall.column, true);
+                }
+            }
+        }
     }
-    else //Drawing vertical wall
+
+    verticalWalls.clear();
+}
+
+//Same division as above, but every chamber has its own counter-based random stream derived from path to the chamber
+//Maze is the same for every count of threads, chambers only write fields inside of them, but neighbour chambers can share words so writes are atomic
+void MazeGeneratorRD::divideChambersParallel(std::int64_t mazeFields)
+{
+    MazeTaskPool<ParallelChamber> pool(threadCount);
+    std::vector<std::vector<ParallelChamber>> workerStacks(pool.getThreadCount());
+    std::vector<std::size_t> workerPeaks(pool.getThreadCount(), 0);
+    bool atomic = pool.getThreadCount() > 1; //Single thread doesn't need to pay for atomic operations
+
+    auto divide = [&](const ParallelChamber& task, unsigned int worker)
     {
-        int wallField = getRandomNumber(startFieldX, endFieldX - 1);
+        if (isCancelled())
+        {
+            return;
+        }
 
-        //Same as before but vertically
-        int wallIndex = wallField * 2 + 1;
-        wallIndex++;
+        std::vector<ParallelChamber>& stack = workerStacks[worker];
+        std::uint64_t divisions = 0, finishedCells = 0;
+        stack.push_back(task);
 
-        for (int i = startFieldY * 2 + 1; i < endFieldY * 2 + 2; i++)
+        while (!stack.empty())
         {
-            mazeArray[i][wallIndex] = true;
+            ParallelChamber chamber = stack.back();
+            stack.pop_back();
+
+            std::int64_t width = chamber.endFieldX - chamber.startFieldX;
+            std::int64_t height = chamber.endFieldY - chamber.startFieldY;
+
+            if (width < 1 || height < 1)
+            {
+                finishedCells += (width + 1) * (height + 1);
+
+                continue;
+            }
+
+            MazeRandom random = getRandomStream(chamber.key);
+            ParallelChamber first = chamber, second = chamber;
+
+            first.key = MazeRandom::getSubstream(chamber.key, 0);
+            second.key = MazeRandom::getSubstream(chamber.key, 1);
+
+            bool horizontal = width < height || (width == height && random.getNumber(0, 1) == Orientation::HORIZONTAL);
+
+            if (horizontal)
+            {
+                std::int64_t wallField = random.getNumber(chamber.startFieldY, chamber.endFieldY - 1);
+                std::int64_t wallIndex = wallField * 2 + 2;
+                std::int64_t passageIndex = random.getNumber(chamber.startFieldX, chamber.endFieldX) * 2 + 1;
+
+                mazeArray.fillRow(wallIndex, chamber.startFieldX * 2 + 1, chamber.endFieldX * 2 + 2, true, atomic);
+                mazeArray.fillRow(wallIndex, passageIndex, passageIndex + 1, false, atomic);
+
+                first.endFieldY = wallField;
+                second.startFieldY = wallField + 1;
+            }
+            else
+            {
+                std::int64_t wallField = random.getNumber(chamber.startFieldX, chamber.endFieldX - 1);
+                std::int64_t wallIndex = wallField * 2 + 2;
+                std::int64_t passageIndex = random.getNumber(chamber.startFieldY, chamber.endFieldY) * 2 + 1;
+
+                mazeArray.fillColumn(wallIndex, chamber.startFieldY * 2 + 1, chamber.endFieldY * 2 + 2, true, atomic);
+                mazeArray.fillColumn(wallIndex, passageIndex, passageIndex + 1, false, atomic);
+
+                first.endFieldX = wallField;
+                second.startFieldX = wallField + 1;
+            }
+
+            for (const ParallelChamber& child : { second, first })
+            {
+                if ((child.endFieldX - child.startFieldX + 1) * (child.endFieldY - child.startFieldY + 1) > PARALLEL_CHAMBER_FIELDS)
+                {
+                    pool.push(worker, child);
+                }
+                else
+                {
+                    stack.push_back(child);
+                }
+            }
+
+            workerPeaks[worker] = std::max(workerPeaks[worker], stack.size());
+
+            if (++divisions % PROGRESS_STEP == 0)
+            {
+                addProgress(finishedCells);
+                finishedCells = 0;
+
+                if (isCancelled())
+                {
+                    stack.clear();
+                }
+            }
         }
 
-        int passageField = getRandomNumber(startFieldY, endFieldY);
+        addProgress(finishedCells);
+    };
 
-        mazeArray[passageField * 2 + 1][wallIndex] = false;
+    pool.run({ 0, 0, mazeFields - 1, mazeFields - 1, 0 }, divide);
 
-        
-        divideChamber(startFieldX, startFieldY, wallField, endFieldY, setOrientation(startFieldX, startFieldY, wallField, endFieldY));
-        divideChamber(wallField + 1, startFieldY, endFieldX, endFieldY, setOrientation(startFieldX, startFieldY, wallField, endFieldY));
-    }
+    peakStackSize = *std::max_element(workerPeaks.begin(), workerPeaks.end());
 }
 
 //Choose wall orientation
 //If chamber is wider than higher divide it vertically
 //If chamber is higher than wider divide it horizontally
 //If chamber width and height are same then set random orientation
-MazeGeneratorRD::Orientation MazeGeneratorRD::setOrientation(int startFieldX, int startFieldY, int endFieldX, int endFieldY)
+MazeGeneratorRD::Orientation MazeGeneratorRD::setOrientation(std::int64_t chamberWidth, std::int64_t chamberHeight)
 {
-    int chamberWidth = endFieldX - startFieldX;
-    int chamberHeight = endFieldY - startFieldY;
-
     if (chamberWidth > chamberHeight)
     {
         return Orientation::VERTICAL;
@@ -130,3 +384,6 @@ MazeGeneratorRD::Orientation MazeGeneratorRD::setOrientation(int startFieldX, in
 
     return Orientation(getRandomNumber(0, 1));
 }
+
+static MazeGeneratorRegistrar registrar("RD", "Recursive division, long straight walls", "", MazeGeneratorInfo::PARALLEL | MazeGeneratorInfo::WALL_STORAGE | MazeGeneratorInfo::RESUMABLE, 111.0, 91.0, 0.0,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorRD(size, seed); });
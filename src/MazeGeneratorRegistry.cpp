@@ -0,0 +1,163 @@
+#include "MazeGeneratorRegistry.hpp"
+
+#include <algorithm>
+
+std::uint64_t MazeGeneratorInfo::estimateMemory(std::uint64_t size, MazeGenerator::Storage storage) const
+{
+    //Endless maze keeps only chunks around player
+    if (hasCapability(Capability::ENDLESS))
+    {
+        return 64 * 1024;
+    }
+
+    //Other storages need bits while generating (COMPRESSED) or can have all chunks resident (CHUNKED)
+    double fields = double(size) * double(size);
+    double arrayBytes = storage == MazeGenerator::Storage::WALLS ? fields / 16.0 : fields / 8.0;
+
+    return std::uint64_t(arrayBytes + fields * bytesPerField);
+}
+
+//Registry is created on first use, so registrars can use it from static initialization of any source file
+MazeGeneratorRegistry& MazeGeneratorRegistry::getInstance()
+{
+    static MazeGeneratorRegistry registry;
+
+    return registry;
+}
+
+bool MazeGeneratorRegistry::add(const MazeGeneratorInfo& info)
+{
+    if (find(info.name) != nullptr)
+    {
+        return false;
+    }
+
+    //Static initialization order differs between builds, sorted list is always the same
+    auto position = std::lower_bound(generators.begin(), generators.end(), info, [](const MazeGeneratorInfo& first, const MazeGeneratorInfo& second) {
+        return first.name < second.name;
+    });
+
+    generators.insert(position, info);
+
+    return true;
+}
+
+const MazeGeneratorInfo* MazeGeneratorRegistry::find(const std::string& name) const
+{
+    for (const MazeGeneratorInfo& info : generators)
+    {
+        if (info.name == name)
+        {
+            return &info;
+        }
+    }
+
+    return nullptr;
+}
+
+const std::vector<MazeGeneratorInfo>& MazeGeneratorRegistry::getGenerators() const
+{
+    return generators;
+}
+
+MazeGenerator* MazeGeneratorRegistry::create(const std::string& generator, std::uint64_t size, const std::string& seed) const
+{
+    std::string name, parameters;
+    splitName(generator, name, parameters);
+
+    const MazeGeneratorInfo* info = find(name);
+
+    if (info == nullptr || (info->parameters.empty() && !parameters.empty()))
+    {
+        return nullptr;
+    }
+
+    return info->create(size, seed, parameters);
+}
+
+const MazeGeneratorInfo* MazeGeneratorRegistry::selectFastest(std::uint64_t size, std::uint64_t memoryBudget, unsigned int threads, MazeGenerator::Storage& storage) const
+{
+    const MazeGeneratorInfo* fastest = nullptr;
+    const MazeGeneratorInfo* smallest = nullptr;
+    double fastestSpeed = 0.0, smallestSpeed = 0.0;
+    std::uint64_t fastestMemory = 0, smallestMemory = 0;
+    MazeGenerator::Storage fastestStorage = MazeGenerator::Storage::BITS, smallestStorage = MazeGenerator::Storage::BITS;
+
+    for (const MazeGeneratorInfo& info : generators)
+    {
+        if (info.hasCapability(MazeGeneratorInfo::ENDLESS) || info.hasCapability(MazeGeneratorInfo::BIASED))
+        {
+            continue;
+        }
+
+        for (MazeGenerator::Storage candidate : { MazeGenerator::Storage::BITS, MazeGenerator::Storage::WALLS })
+        {
+            if (candidate == MazeGenerator::Storage::WALLS && !info.hasCapability(MazeGeneratorInfo::WALL_STORAGE))
+            {
+                continue;
+            }
+
+            //Only BITS storage can be generated by more threads
+            bool parallel = threads > 1 && candidate == MazeGenerator::Storage::BITS && info.hasCapability(MazeGeneratorInfo::PARALLEL);
+            double speed = candidate == MazeGenerator::Storage::WALLS ? info.megaFieldsPerSecondWalls : info.megaFieldsPerSecond * (parallel ? threads : 1);
+            std::uint64_t memory = info.estimateMemory(size, candidate);
+
+            if (smallest == nullptr || memory < smallestMemory || (memory == smallestMemory && speed > smallestSpeed))
+            {
+                smallest = &info;
+                smallestSpeed = speed;
+                smallestMemory = memory;
+                smallestStorage = candidate;
+            }
+
+            if (memoryBudget != 0 && memory > memoryBudget)
+            {
+                continue;
+            }
+
+            if (fastest == nullptr || speed > fastestSpeed || (speed == fastestSpeed && memory < fastestMemory))
+            {
+                fastest = &info;
+                fastestSpeed = speed;
+                fastestMemory = memory;
+                fastestStorage = candidate;
+            }
+        }
+    }
+
+    if (fastest == nullptr)
+    {
+        storage = smallestStorage;
+
+        return smallest;
+    }
+
+    storage = fastestStorage;
+
+    return fastest;
+}
+
+void MazeGeneratorRegistry::splitName(const std::string& generator, std::string& name, std::string& parameters)
+{
+    std::size_t colon = generator.find(':');
+
+    name = generator.substr(0, colon);
+    parameters = colon == std::string::npos ? "" : generator.substr(colon + 1);
+}
+
+MazeGeneratorRegistrar::MazeGeneratorRegistrar(const std::string& name, const std::string& description, const std::string& parameters, unsigned int capabilities,
+                                               double megaFieldsPerSecond, double megaFieldsPerSecondWalls, double bytesPerField, MazeGeneratorInfo::Factory create)
+{
+    MazeGeneratorInfo info;
+
+    info.name = name;
+    info.description = description;
+    info.parameters = parameters;
+    info.capabilities = capabilities;
+    info.megaFieldsPerSecond = megaFieldsPerSecond;
+    info.megaFieldsPerSecondWalls = megaFieldsPerSecondWalls;
+    info.bytesPerField = bytesPerField;
+    info.create = create;
+
+    MazeGeneratorRegistry::getInstance().add(info);
+}
@@ -0,0 +1,220 @@
+#include "MazeGeneratorRows.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#if defined(__AVX2__)
+    #define GLMAZE_AVX2
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define GLMAZE_SSE2
+    #include <emmintrin.h>
+#endif
+
+//Move bit i of low 32 bits to bit 2 * i
+static std::uint64_t spreadWord(std::uint64_t bits)
+{
+    bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFULL;
+    bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFULL;
+    bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    bits = (bits | (bits << 2)) & 0x3333333333333333ULL;
+
+    return (bits | (bits << 1)) & 0x5555555555555555ULL;
+}
+
+MazeGeneratorRows::MazeGeneratorRows(std::uint64_t size, std::string seed)
+: MazeGenerator(size, seed)
+{
+    mazeSize = size;
+
+    if (mazeSize % 2 == 0) //Cells are on odd indices and walls on even ones like in RD
+    {
+        mazeSize++;
+    }
+
+    wallStorageSupported = true;
+    parallelSupported = true;
+}
+
+void MazeGeneratorRows::generateMaze()
+{
+    //Every word of every row of fields is written by band, so array doesn't need to be cleared or filled first
+    allocateArray(false);
+
+    cellColumns = (mazeSize - 1) / 2;
+    cellRows = (mazeSize - 1) / 2;
+
+    std::uint64_t bandCount = (mazeSize + BAND_ROWS - 1) / BAND_ROWS;
+    unsigned int threads = std::max(1u, std::min<unsigned int>(threadCount, bandCount));
+    std::atomic<std::uint64_t> nextBand(0);
+
+    startProgress(bandCount);
+
+    auto processBands = [this, &nextBand, bandCount]()
+    {
+        RowWork work;
+        std::size_t words = (mazeSize + 63) / 64;
+
+        work.cellBits.resize(words);
+        work.upBits.resize(words);
+        work.wallWords.resize(words);
+        work.cellWords.resize(words);
+
+        for (std::uint64_t band = nextBand++; band < bandCount && !isCancelled(); band = nextBand++)
+        {
+            carveBand(band, work);
+            addProgress(1);
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    for (unsigned int i = 1; i < threads; i++)
+    {
+        workers.emplace_back(processBands);
+    }
+
+    processBands();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (isCancelled())
+    {
+        return;
+    }
+
+    setExit();
+    setStartPosition();
+}
+
+void MazeGeneratorRows::fillCellBits(RowWork& work, MazeSequentialRandom* random)
+{
+    for (std::size_t i = 0; i < work.cellBits.size(); i += 2)
+    {
+        std::uint64_t bits = random ? random->next() : 0;
+
+        work.cellBits[i] = std::uint32_t(bits);
+
+        if (i + 1 < work.cellBits.size())
+        {
+            work.cellBits[i + 1] = std::uint32_t(bits >> 32);
+        }
+    }
+
+    //Left border and right border (it's wall left of cell after last cell)
+    work.cellBits[0] |= 1;
+    work.cellBits[cellColumns / 32] |= ~std::uint32_t(0) << (cellColumns % 32);
+
+    std::fill(work.cellBits.begin() + cellColumns / 32 + 1, work.cellBits.end(), ~std::uint32_t(0));
+}
+
+void MazeGeneratorRows::spreadBits(const std::uint32_t* bits, std::uint64_t* words, std::size_t count, bool passages)
+{
+    std::size_t i = 0;
+
+    #if defined(GLMAZE_AVX2)
+        const __m256i masks[5] = { _mm256_set1_epi64x(0x0000FFFF0000FFFFLL), _mm256_set1_epi64x(0x00FF00FF00FF00FFLL),
+                                   _mm256_set1_epi64x(0x0F0F0F0F0F0F0F0FLL), _mm256_set1_epi64x(0x3333333333333333LL),
+                                   _mm256_set1_epi64x(0x5555555555555555LL) };
+        const __m256i ones = _mm256_set1_epi64x(-1);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256i spread = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + i)));
+
+            spread = _mm256_and_si256(_mm256_or_si256(spread, _mm256_slli_epi64(spread, 16)), masks[0]);
+            spread = _mm256_and_si256(_mm256_or_si256(spread, _mm256_slli_epi64(spread, 8)), masks[1]);
+            spread = _mm256_and_si256(_mm256_or_si256(spread, _mm256_slli_epi64(spread, 4)), masks[2]);
+            spread = _mm256_and_si256(_mm256_or_si256(spread, _mm256_slli_epi64(spread, 2)), masks[3]);
+            spread = _mm256_and_si256(_mm256_or_si256(spread, _mm256_slli_epi64(spread, 1)), masks[4]);
+
+            if (passages)
+            {
+                spread = _mm256_xor_si256(_mm256_slli_epi64(spread, 1), ones);
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(words + i), spread);
+        }
+    #elif defined(GLMAZE_SSE2)
+        const __m128i masks[5] = { _mm_set1_epi64x(0x0000FFFF0000FFFFLL), _mm_set1_epi64x(0x00FF00FF00FF00FFLL),
+                                   _mm_set1_epi64x(0x0F0F0F0F0F0F0F0FLL), _mm_set1_epi64x(0x3333333333333333LL),
+                                   _mm_set1_epi64x(0x5555555555555555LL) };
+        const __m128i ones = _mm_set1_epi64x(-1);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128i spread = _mm_unpacklo_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bits + i)), _mm_setzero_si128());
+
+            spread = _mm_and_si128(_mm_or_si128(spread, _mm_slli_epi64(spread, 16)), masks[0]);
+            spread = _mm_and_si128(_mm_or_si128(spread, _mm_slli_epi64(spread, 8)), masks[1]);
+            spread = _mm_and_si128(_mm_or_si128(spread, _mm_slli_epi64(spread, 4)), masks[2]);
+            spread = _mm_and_si128(_mm_or_si128(spread, _mm_slli_epi64(spread, 2)), masks[3]);
+            spread = _mm_and_si128(_mm_or_si128(spread, _mm_slli_epi64(spread, 1)), masks[4]);
+
+            if (passages)
+            {
+                spread = _mm_xor_si128(_mm_slli_epi64(spread, 1), ones);
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), spread);
+        }
+    #endif
+
+    for (; i < count; i++)
+    {
+        words[i] = passages ? ~(spreadWord(bits[i]) << 1) : spreadWord(bits[i]);
+    }
+}
+
+//Carve all rows of fields in band, row of cells is always in the same band as row of fields above it
+void MazeGeneratorRows::carveBand(std::uint64_t band, RowWork& work)
+{
+    std::uint64_t startRow = band * BAND_ROWS;
+    std::uint64_t endRow = std::min(startRow + BAND_ROWS, mazeSize);
+
+    for (std::uint64_t cellRow = startRow / 2; cellRow < std::min(endRow / 2, cellRows); cellRow++)
+    {
+        MazeRandom rowStream = getRandomStream(cellRow);
+        MazeSequentialRandom random(rowStream);
+
+        carveRow(cellRow, random, work);
+
+        writeRow(cellRow * 2, work.wallWords);
+        writeRow(cellRow * 2 + 1, work.cellWords);
+    }
+
+    //Bottom border
+    if (endRow == mazeSize)
+    {
+        std::fill(work.wallWords.begin(), work.wallWords.end(), ~std::uint64_t(0));
+        writeRow(mazeSize - 1, work.wallWords);
+    }
+}
+
+//Write whole row of fields, fields after last column are set to walls like in filled array
+void MazeGeneratorRows::writeRow(std::uint64_t row, std::vector<std::uint64_t>& words)
+{
+    if (mazeSize % 64 != 0)
+    {
+        words.back() |= ~std::uint64_t(0) << (mazeSize % 64);
+    }
+
+    if (storage)
+    {
+        for (std::uint64_t column = 0; column < mazeSize; column++)
+        {
+            storage->set(row, column, (words[column >> 6] >> (column & 63)) & 1);
+        }
+    }
+    else
+    {
+        for (std::size_t word = 0; word < words.size(); word++)
+        {
+            mazeArray.setBits(row, word * 64, words[word]);
+        }
+    }
+}
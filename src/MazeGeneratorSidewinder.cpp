@@ -0,0 +1,50 @@
+#include "MazeGeneratorSidewinder.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+#include <algorithm>
+
+MazeGeneratorSidewinder::MazeGeneratorSidewinder(std::uint64_t size, std::string seed)
+: MazeGeneratorRows(size, seed)
+{
+}
+
+//Set bit means wall left of cell, so run of cells starts there
+void MazeGeneratorSidewinder::carveRow(std::uint64_t cellRow, MazeSequentialRandom& random, RowWork& work)
+{
+    fillCellBits(work, cellRow == 0 ? nullptr : &random);
+    spreadBits(work.cellBits.data(), work.cellWords.data(), work.cellBits.size(), false);
+
+    if (cellRow == 0)
+    {
+        //Top row is corridor under top border
+        std::fill(work.wallWords.begin(), work.wallWords.end(), ~std::uint64_t(0));
+
+        return;
+    }
+
+    //Every run goes up from its first cell with random bit set, or from its last cell when no cell has it
+    //It's lowest candidate bit of every run, subtracting run starts from candidates clears exactly that bit (borrow stops on it)
+    //So runs of 1 and 2 cells choose uniformly and longer runs prefer cells near start a bit
+    std::uint64_t borrow = 0;
+    std::uint64_t randomBits = 0;
+
+    for (std::size_t word = 0; word < work.cellBits.size(); word++)
+    {
+        std::uint32_t starts = work.cellBits[word];
+        std::uint32_t nextStarts = word + 1 < work.cellBits.size() ? work.cellBits[word + 1] : 1;
+        std::uint32_t ends = (starts >> 1) | (nextStarts << 31);
+
+        randomBits = word % 2 == 0 ? random.next() : randomBits >> 32;
+
+        std::uint32_t candidates = std::uint32_t(randomBits) | ends;
+        std::uint64_t difference = std::uint64_t(candidates) - starts - borrow;
+
+        borrow = difference >> 63;
+        work.upBits[word] = candidates & ~std::uint32_t(difference);
+    }
+
+    spreadBits(work.upBits.data(), work.wallWords.data(), work.upBits.size(), true);
+}
+
+static MazeGeneratorRegistrar registrar("SIDEWINDER", "Sidewinder, corridor along top border", "", MazeGeneratorInfo::PARALLEL | MazeGeneratorInfo::WALL_STORAGE | MazeGeneratorInfo::BIASED, 8900.0, 220.0, 0.0,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorSidewinder(size, seed); });
@@ -0,0 +1,225 @@
+#include "MazeGeneratorWilson.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+static unsigned int countTrailingZeros(std::uint64_t value)
+{
+    #if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+
+        return index;
+    #elif defined(_MSC_VER)
+        unsigned long index;
+
+        if (_BitScanForward(&index, unsigned(value)))
+        {
+            return index;
+        }
+
+        _BitScanForward(&index, unsigned(value >> 32));
+
+        return index + 32;
+    #else
+        return __builtin_ctzll(value);
+    #endif
+}
+
+MazeGeneratorWilson::MazeGeneratorWilson(std::uint64_t size, std::string seed)
+: MazeGenerator(size, seed)
+{
+    mazeSize = size;
+
+    if (mazeSize % 2 == 0) //Cells are on odd indices and walls on even ones like in RD
+    {
+        mazeSize++;
+    }
+
+    wallStorageSupported = true;
+}
+
+void MazeGeneratorWilson::generateMaze()
+{
+    allocateArray(false);
+
+    fillFields(true);
+
+    cellColumns = (mazeSize - 1) / 2;
+    cellRows = (mazeSize - 1) / 2;
+
+    std::uint64_t cellCount = cellColumns * cellRows;
+
+    treeCells.assign((cellCount + 63) / 64, 0);
+    cellMoves.assign((cellCount + 3) / 4, 0);
+
+    //Bits after last cell are set, so scan for free cell never stops there
+    if (cellCount % 64 != 0)
+    {
+        treeCells.back() = ~std::uint64_t(0) << (cellCount % 64);
+    }
+
+    //Walks use billions of random moves on big mazes, every 64-bit number gives 32 moves
+    MazeRandom random = getRandomStream(0);
+    std::uint64_t randomBits = 0;
+    unsigned int randomMoves = 0;
+
+    //Maze starts as one random cell
+    std::uint64_t root = random.getBounded(cellCount);
+
+    treeCells[root >> 6] |= std::uint64_t(1) << (root & 63);
+    setField((root / cellColumns) * 2 + 1, (root % cellColumns) * 2 + 1, false);
+
+    std::uint64_t treeSize = 1;
+    startProgress(cellCount);
+
+    for (std::uint64_t start = findFreeCell(0); start < cellCount; start = findFreeCell(start))
+    {
+        //Random walk until it hits maze, cell remembers only move of its last visit (loops are erased)
+        //Position is kept also as row and column, so walk doesn't need division
+        std::uint64_t cell = start;
+        std::uint64_t row = start / cellColumns;
+        std::uint64_t column = start % cellColumns;
+
+        while (!isInTree(cell))
+        {
+            if (randomMoves == 0)
+            {
+                //First walks can be very long, so cancel is checked while walking
+                if (isCancelled())
+                {
+                    break;
+                }
+
+                randomBits = random.next();
+                randomMoves = 32;
+            }
+
+            Move move = Move(randomBits & 3);
+            randomBits >>= 2;
+            randomMoves--;
+
+            //Moves out of maze are skipped
+            switch (move)
+            {
+                case Move::UP:
+                    if (row == 0) continue;
+                    setMove(cell, move);
+                    row--;
+                    cell -= cellColumns;
+                    break;
+
+                case Move::DOWN:
+                    if (row == cellRows - 1) continue;
+                    setMove(cell, move);
+                    row++;
+                    cell += cellColumns;
+                    break;
+
+                case Move::LEFT:
+                    if (column == 0) continue;
+                    setMove(cell, move);
+                    column--;
+                    cell--;
+                    break;
+
+                case Move::RIGHT:
+                    if (column == cellColumns - 1) continue;
+                    setMove(cell, move);
+                    column++;
+                    cell++;
+                    break;
+            }
+        }
+
+        if (isCancelled())
+        {
+            break;
+        }
+
+        //Follow loop-erased walk from start and carve it
+        cell = start;
+        row = (start / cellColumns) * 2 + 1;
+        column = (start % cellColumns) * 2 + 1;
+
+        while (!isInTree(cell))
+        {
+            Move move = getMove(cell);
+
+            treeCells[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+            setField(row, column, false);
+
+            if (++treeSize % PROGRESS_STEP == 0)
+            {
+                setProgress(treeSize);
+            }
+
+            switch (move)
+            {
+                case Move::UP:
+                    setField(row - 1, column, false);
+                    row -= 2;
+                    cell -= cellColumns;
+                    break;
+
+                case Move::DOWN:
+                    setField(row + 1, column, false);
+                    row += 2;
+                    cell += cellColumns;
+                    break;
+
+                case Move::LEFT:
+                    setField(row, column - 1, false);
+                    column -= 2;
+                    cell--;
+                    break;
+
+                case Move::RIGHT:
+                    setField(row, column + 1, false);
+                    column += 2;
+                    cell++;
+                    break;
+            }
+        }
+    }
+
+    treeCells.clear();
+    cellMoves.clear();
+
+    treeCells.shrink_to_fit();
+    cellMoves.shrink_to_fit();
+
+    if (isCancelled())
+    {
+        return;
+    }
+
+    setExit();
+    setStartPosition();
+}
+
+//Find first cell from given one that is not in maze yet, 64 cells are checked at once (returns count of cells if there is none)
+std::uint64_t MazeGeneratorWilson::findFreeCell(std::uint64_t cell) const
+{
+    for (std::uint64_t word = cell >> 6; word < treeCells.size(); word++)
+    {
+        std::uint64_t freeCells = ~treeCells[word];
+
+        if (word == cell >> 6)
+        {
+            freeCells &= ~std::uint64_t(0) << (cell & 63);
+        }
+
+        if (freeCells != 0)
+        {
+            return word * 64 + countTrailingZeros(freeCells);
+        }
+    }
+
+    return cellColumns * cellRows;
+}
+
+static MazeGeneratorRegistrar registrar("WILSON", "Loop-erased random walks, uniform spanning tree", "", MazeGeneratorInfo::WALL_STORAGE, 13.0, 12.0, 3.0 / 32.0,
+    [](std::uint64_t size, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorWilson(size, seed); });
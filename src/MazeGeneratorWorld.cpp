@@ -0,0 +1,44 @@
+#include "MazeGeneratorWorld.hpp"
+#include "MazeGeneratorRegistry.hpp"
+
+MazeGeneratorWorld::MazeGeneratorWorld(std::string seed, std::uint64_t radius)
+: MazeGenerator(MazeWorld::WORLD_SIZE, seed), radius(radius)
+{
+    world = nullptr;
+    wallStorageSupported = false;
+    parallelSupported = false;
+}
+
+//Only chunks around start are generated, so it takes the same time for every seed
+void MazeGeneratorWorld::generateMaze()
+{
+    world = new MazeWorld(seedKey, radius);
+    storage.reset(world);
+    arrayAllocated = true;
+
+    //Fields with both indices odd are cells, they are always open
+    startX = MazeWorld::WORLD_SIZE / 2 + 1;
+    startY = MazeWorld::WORLD_SIZE / 2 + 1;
+
+    //Corner of world is closed, so exit is never reached
+    endX = 0;
+    endY = 0;
+    endBorder = Direction::TOP;
+
+    world->update(startY, startX);
+
+    startProgress(1);
+    setProgress(1);
+}
+
+void MazeGeneratorWorld::updatePosition(std::uint64_t row, std::uint64_t column)
+{
+    if (world)
+    {
+        world->update(row, column);
+    }
+}
+
+//Size is ignored, world has always the same size
+static MazeGeneratorRegistrar registrar("ENDLESS", "Endless maze generated in chunks around player", "", MazeGeneratorInfo::ENDLESS, 0.0, 0.0, 0.0,
+    [](std::uint64_t, const std::string& seed, const std::string&) -> MazeGenerator* { return new MazeGeneratorWorld(seed); });
@@ -0,0 +1,152 @@
+#include "MazeMappedFile.hpp"
+
+#include <iostream>
+
+#if defined(WIN32) || defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+MazeMappedFile::MazeMappedFile()
+{
+    data = nullptr;
+    size = 0;
+
+    #if defined(WIN32) || defined(_WIN32)
+        fileHandle = INVALID_HANDLE_VALUE;
+        mappingHandle = nullptr;
+    #else
+        fileDescriptor = -1;
+    #endif
+}
+
+MazeMappedFile::~MazeMappedFile()
+{
+    close();
+}
+
+//Open (or create) file, resize it to given size and map it into memory
+bool MazeMappedFile::open(const std::string& path, std::size_t size)
+{
+    close();
+
+    if (size == 0)
+    {
+        return false;
+    }
+
+    #if defined(WIN32) || defined(_WIN32)
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            std::cerr << "Failed opening maze file " << path << std::endl;
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        fileSize.QuadPart = size;
+
+        if (!SetFilePointerEx(fileHandle, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(fileHandle))
+        {
+            std::cerr << "Failed resizing maze file " << path << std::endl;
+            close();
+            return false;
+        }
+
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE, fileSize.HighPart, fileSize.LowPart, nullptr);
+
+        if (mappingHandle == nullptr)
+        {
+            std::cerr << "Failed mapping maze file " << path << std::endl;
+            close();
+            return false;
+        }
+
+        data = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    #else
+        fileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+        if (fileDescriptor == -1)
+        {
+            std::cerr << "Failed opening maze file " << path << std::endl;
+            return false;
+        }
+
+        if (ftruncate(fileDescriptor, size) != 0)
+        {
+            std::cerr << "Failed resizing maze file " << path << std::endl;
+            close();
+            return false;
+        }
+
+        data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+
+        if (data == MAP_FAILED)
+        {
+            data = nullptr;
+        }
+    #endif
+
+    if (data == nullptr)
+    {
+        std::cerr << "Failed mapping maze file " << path << std::endl;
+        close();
+        return false;
+    }
+
+    this->size = size;
+
+    return true;
+}
+
+//Unmap memory and close file, file itself is left on disk
+void MazeMappedFile::close()
+{
+    #if defined(WIN32) || defined(_WIN32)
+        if (data != nullptr)
+        {
+            UnmapViewOfFile(data);
+        }
+
+        if (mappingHandle != nullptr)
+        {
+            CloseHandle(mappingHandle);
+            mappingHandle = nullptr;
+        }
+
+        if (fileHandle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(fileHandle);
+            fileHandle = INVALID_HANDLE_VALUE;
+        }
+    #else
+        if (data != nullptr)
+        {
+            munmap(data, size);
+        }
+
+        if (fileDescriptor != -1)
+        {
+            ::close(fileDescriptor);
+            fileDescriptor = -1;
+        }
+    #endif
+
+    data = nullptr;
+    size = 0;
+}
+
+void* MazeMappedFile::getData() const
+{
+    return data;
+}
+
+std::size_t MazeMappedFile::getSize() const
+{
+    return size;
+}
@@ -0,0 +1,278 @@
+#include "MazeOccupancyPyramid.hpp"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+static unsigned int countBits(std::uint64_t value)
+{
+    #if defined(_MSC_VER) && defined(_M_X64)
+        return unsigned(__popcnt64(value));
+    #elif defined(_MSC_VER)
+        return __popcnt(unsigned(value)) + __popcnt(unsigned(value >> 32));
+    #else
+        return __builtin_popcountll(value);
+    #endif
+}
+
+MazeOccupancyPyramid::MazeOccupancyPyramid(const MazeGridView& mazeArray)
+{
+    this->mazeArray = mazeArray;
+    size = mazeArray.getRows();
+
+    //Halve resolution until one block covers whole maze
+    std::uint64_t blocks = (size + 7) / 8;
+    blocksPerRow.push_back(blocks);
+
+    while (blocks > 1)
+    {
+        blocks = (blocks + 1) / 2;
+        blocksPerRow.push_back(blocks);
+    }
+}
+
+void MazeOccupancyPyramid::build()
+{
+    std::uint64_t baseBlocks = blocksPerRow[0];
+    baseLevel.assign(baseBlocks * baseBlocks, 0);
+
+    //Every word of row holds one row of 8 blocks
+    for (std::uint64_t row = 0; row < size; row++)
+    {
+        std::uint8_t* blocks = &baseLevel[(row >> 3) * baseBlocks];
+
+        for (std::uint64_t column = 0; column < size; column += 64)
+        {
+            std::uint64_t bits = mazeArray.getBits(row, column);
+
+            for (std::uint64_t block = column >> 3; block < std::min((column >> 3) + 8, baseBlocks); block++, bits >>= 8)
+            {
+                blocks[block] += countBits(bits & 0xFF);
+            }
+        }
+    }
+
+    secondLevel.clear();
+    upperLevels.clear();
+
+    if (blocksPerRow.size() > 1)
+    {
+        secondLevel.assign(blocksPerRow[1] * blocksPerRow[1], 0);
+    }
+
+    for (unsigned int level = 2; level < blocksPerRow.size(); level++)
+    {
+        upperLevels.emplace_back(blocksPerRow[level] * blocksPerRow[level], 0);
+    }
+
+    for (unsigned int level = 1; level < blocksPerRow.size(); level++)
+    {
+        for (std::uint64_t i = 0; i < blocksPerRow[level - 1]; i++)
+        {
+            for (std::uint64_t j = 0; j < blocksPerRow[level - 1]; j++)
+            {
+                addWalls(level, i >> 1, j >> 1, getWalls(level - 1, i, j));
+            }
+        }
+    }
+}
+
+void MazeOccupancyPyramid::update(std::uint64_t row, std::uint64_t column)
+{
+    std::uint64_t blockRow = row >> 3;
+    std::uint64_t blockColumn = column >> 3;
+
+    std::uint8_t& base = baseLevel[blockRow * blocksPerRow[0] + blockColumn];
+    std::uint8_t count = countBlock(blockRow, blockColumn);
+
+    if (count == base)
+    {
+        return;
+    }
+
+    std::int64_t difference = std::int64_t(count) - base;
+    base = count;
+
+    for (unsigned int level = 1; level < blocksPerRow.size(); level++)
+    {
+        blockRow >>= 1;
+        blockColumn >>= 1;
+
+        addWalls(level, blockRow, blockColumn, difference);
+    }
+}
+
+std::uint64_t MazeOccupancyPyramid::countWalls(std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const
+{
+    endRow = std::min(endRow, size);
+    endColumn = std::min(endColumn, size);
+
+    if (startRow >= endRow || startColumn >= endColumn)
+    {
+        return 0;
+    }
+
+    return countRegion(blocksPerRow.size() - 1, 0, 0, startRow, startColumn, endRow, endColumn);
+}
+
+bool MazeOccupancyPyramid::anyOpen(std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const
+{
+    return !allWalls(startRow, startColumn, endRow, endColumn);
+}
+
+bool MazeOccupancyPyramid::allWalls(std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const
+{
+    endRow = std::min(endRow, size);
+    endColumn = std::min(endColumn, size);
+
+    if (startRow >= endRow || startColumn >= endColumn)
+    {
+        return true;
+    }
+
+    return countWalls(startRow, startColumn, endRow, endColumn) == (endRow - startRow) * (endColumn - startColumn);
+}
+
+unsigned int MazeOccupancyPyramid::getLevelCount() const
+{
+    return blocksPerRow.size();
+}
+
+//Get size of block side in fields
+std::uint64_t MazeOccupancyPyramid::getBlockSize(unsigned int level) const
+{
+    return std::uint64_t(8) << level;
+}
+
+std::uint64_t MazeOccupancyPyramid::getBlocksPerRow(unsigned int level) const
+{
+    return blocksPerRow[level];
+}
+
+std::uint64_t MazeOccupancyPyramid::getWalls(unsigned int level, std::uint64_t blockRow, std::uint64_t blockColumn) const
+{
+    std::uint64_t block = blockRow * blocksPerRow[level] + blockColumn;
+
+    if (level == 0)
+    {
+        return baseLevel[block];
+    }
+
+    if (level == 1)
+    {
+        return secondLevel[block];
+    }
+
+    return upperLevels[level - 2][block];
+}
+
+std::size_t MazeOccupancyPyramid::getMemoryUsage() const
+{
+    std::size_t memory = baseLevel.size() + secondLevel.size() * sizeof(std::uint16_t);
+
+    for (auto& counts : upperLevels)
+    {
+        memory += counts.size() * sizeof(std::uint64_t);
+    }
+
+    return memory;
+}
+
+//Add (or remove when negative) walls to block count of level 1 or above
+void MazeOccupancyPyramid::addWalls(unsigned int level, std::uint64_t blockRow, std::uint64_t blockColumn, std::int64_t walls)
+{
+    std::uint64_t block = blockRow * blocksPerRow[level] + blockColumn;
+
+    if (level == 1)
+    {
+        secondLevel[block] = std::uint16_t(secondLevel[block] + walls);
+    }
+    else
+    {
+        upperLevels[level - 2][block] += walls;
+    }
+}
+
+//Count walls in 8x8 block directly from maze array
+std::uint8_t MazeOccupancyPyramid::countBlock(std::uint64_t blockRow, std::uint64_t blockColumn) const
+{
+    std::uint64_t column = blockColumn * 8;
+    unsigned int count = 0;
+
+    for (std::uint64_t row = blockRow * 8; row < std::min(blockRow * 8 + 8, size); row++)
+    {
+        count += countBits((mazeArray.getBits(row, column & ~std::uint64_t(63)) >> (column & 63)) & 0xFF);
+    }
+
+    return count;
+}
+
+//Count walls in rectangle directly from maze array (used for parts of base blocks)
+std::uint64_t MazeOccupancyPyramid::countFields(std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const
+{
+    std::uint64_t count = 0;
+
+    for (std::uint64_t row = startRow; row < endRow; row++)
+    {
+        for (std::uint64_t column = startColumn; column < endColumn; column = (column | 63) + 1)
+        {
+            std::uint64_t bits = mazeArray.getBits(row, column & ~std::uint64_t(63)) >> (column & 63);
+            std::uint64_t fields = std::min<std::uint64_t>(endColumn - column, 64 - (column & 63));
+
+            if (fields < 64)
+            {
+                bits &= (std::uint64_t(1) << fields) - 1;
+            }
+
+            count += countBits(bits);
+        }
+    }
+
+    return count;
+}
+
+//Walk down from block at given level, blocks fully inside of rectangle are counted from pyramid
+std::uint64_t MazeOccupancyPyramid::countRegion(unsigned int level, std::uint64_t blockRow, std::uint64_t blockColumn,
+                                                std::uint64_t startRow, std::uint64_t startColumn, std::uint64_t endRow, std::uint64_t endColumn) const
+{
+    std::uint64_t blockSize = getBlockSize(level);
+    std::uint64_t blockStartRow = blockRow * blockSize;
+    std::uint64_t blockStartColumn = blockColumn * blockSize;
+    std::uint64_t blockEndRow = std::min(blockStartRow + blockSize, size);
+    std::uint64_t blockEndColumn = std::min(blockStartColumn + blockSize, size);
+
+    //Intersection of block and rectangle
+    std::uint64_t fromRow = std::max(startRow, blockStartRow);
+    std::uint64_t fromColumn = std::max(startColumn, blockStartColumn);
+    std::uint64_t toRow = std::min(endRow, blockEndRow);
+    std::uint64_t toColumn = std::min(endColumn, blockEndColumn);
+
+    if (fromRow >= toRow || fromColumn >= toColumn)
+    {
+        return 0;
+    }
+
+    if (fromRow == blockStartRow && fromColumn == blockStartColumn && toRow == blockEndRow && toColumn == blockEndColumn)
+    {
+        return getWalls(level, blockRow, blockColumn);
+    }
+
+    if (level == 0)
+    {
+        return countFields(fromRow, fromColumn, toRow, toColumn);
+    }
+
+    std::uint64_t count = 0;
+
+    for (std::uint64_t i = blockRow * 2; i < std::min(blockRow * 2 + 2, blocksPerRow[level - 1]); i++)
+    {
+        for (std::uint64_t j = blockColumn * 2; j < std::min(blockColumn * 2 + 2, blocksPerRow[level - 1]); j++)
+        {
+            count += countRegion(level - 1, i, j, fromRow, fromColumn, toRow, toColumn);
+        }
+    }
+
+    return count;
+}
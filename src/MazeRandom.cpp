@@ -0,0 +1,63 @@
+#include "MazeRandom.hpp"
+
+MazeRandom::MazeRandom(std::uint64_t seed, std::uint64_t stream)
+{
+    this->seed = seed;
+    this->stream = stream;
+
+    counter = 0;
+    blockIndex = ~std::uint64_t(0);
+    spare = 0;
+    hasSpare = false;
+}
+
+//FNV-1a hash of seed string
+std::uint64_t MazeRandom::hashSeed(const std::string& seed)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for (unsigned char character : seed)
+    {
+        hash = (hash ^ character) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+//SplitMix64 finalizer of parent stream and index, it doesn't depend on order in which streams are derived
+std::uint64_t MazeRandom::getSubstream(std::uint64_t stream, std::uint64_t index)
+{
+    std::uint64_t key = stream + (index + 1) * 0x9E3779B97F4A7C15ULL;
+
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+
+    return key ^ (key >> 31);
+}
+
+//Whole blocks are written directly, only unaligned first and last number go through next()
+void MazeRandom::fill(std::uint64_t* values, std::size_t count)
+{
+    std::size_t i = 0;
+    hasSpare = false;
+
+    if (count > 0 && (counter & 1))
+    {
+        values[i++] = next();
+    }
+
+    for (; i + 2 <= count; i += 2)
+    {
+        std::uint32_t output[4];
+        generateBlock(seed, stream, counter >> 1, output);
+
+        values[i] = (std::uint64_t(output[1]) << 32) | output[0];
+        values[i + 1] = (std::uint64_t(output[3]) << 32) | output[2];
+        counter += 2;
+    }
+
+    if (i < count)
+    {
+        values[i] = next();
+    }
+}
@@ -0,0 +1,402 @@
+#include "MazeTileStore.hpp"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+//Tile row encoding, every row starts with header byte:
+//0xFF - raw row, 8 bytes follow
+//0xFE - previous row repeated, count of repeats follows
+//0xFD - lattice row, 4 bytes with walls between cells follow (see below)
+//Other - run-length encoded row, bit 7 is value of first run and bits 0-6 are count of runs (1-8),
+//        lengths of all runs except the last one follow (last run fills rest of row)
+static const std::uint8_t ROW_RAW = 0xFF;
+static const std::uint8_t ROW_REPEAT = 0xFE;
+static const std::uint8_t ROW_LATTICE = 0xFD;
+static const unsigned int MAX_RUNS = 8;
+
+//Generators with cells on odd indices (RD) have walls on all fields with both indices even and empty fields on both indices odd
+//Only other half of row carries information, so lattice row stores just these 32 fields
+//Tiles start on even row and column, so parity inside tile is the same as in maze
+static const std::uint64_t EVEN_BITS = 0x5555555555555555ULL;
+static const std::uint64_t ODD_BITS = 0xAAAAAAAAAAAAAAAAULL;
+
+//Tile index of empty cache slot
+static const std::size_t NO_TILE = ~std::size_t(0);
+
+//Move even bits of value to lower 32 bits
+static std::uint32_t packEvenBits(std::uint64_t value)
+{
+    value &= EVEN_BITS;
+    value = (value | (value >> 1)) & 0x3333333333333333ULL;
+    value = (value | (value >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    value = (value | (value >> 4)) & 0x00FF00FF00FF00FFULL;
+    value = (value | (value >> 8)) & 0x0000FFFF0000FFFFULL;
+    value = (value | (value >> 16)) & 0x00000000FFFFFFFFULL;
+
+    return std::uint32_t(value);
+}
+
+//Inverse of packEvenBits
+static std::uint64_t spreadEvenBits(std::uint32_t packed)
+{
+    std::uint64_t value = packed;
+    value = (value | (value << 16)) & 0x0000FFFF0000FFFFULL;
+    value = (value | (value << 8)) & 0x00FF00FF00FF00FFULL;
+    value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    value = (value | (value << 2)) & 0x3333333333333333ULL;
+    value = (value | (value << 1)) & EVEN_BITS;
+
+    return value;
+}
+
+static unsigned int countTrailingZeros(std::uint64_t value)
+{
+    #if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+
+        return index;
+    #else
+        return __builtin_ctzll(value);
+    #endif
+}
+
+MazeTileStore::MazeTileStore(const MazeGridView& source, std::size_t cacheTiles)
+{
+    size = source.getRows();
+    tilesPerRow = (size + 63) / 64;
+    staleBytes = 0;
+
+    this->cacheTiles = std::max<std::size_t>(cacheTiles, 1);
+    cacheWords.assign(this->cacheTiles * 64, 0);
+    slotTiles.assign(this->cacheTiles, NO_TILE);
+    slotUses.assign(this->cacheTiles, 0);
+
+    useCounter = 0;
+    cacheHits = 0;
+    cacheMisses = 0;
+    usedSlots = 0;
+    lastTile = NO_TILE;
+    lastWords = nullptr;
+
+    tileOffsets.resize(tilesPerRow * tilesPerRow);
+    tileSizes.resize(tilesPerRow * tilesPerRow);
+
+    std::uint64_t words[64];
+
+    for (std::size_t tileRow = 0; tileRow < tilesPerRow; tileRow++)
+    {
+        for (std::size_t tileColumn = 0; tileColumn < tilesPerRow; tileColumn++)
+        {
+            for (std::uint64_t i = 0; i < 64; i++)
+            {
+                std::uint64_t row = tileRow * 64 + i;
+                words[i] = row < size ? source.getBits(row, tileColumn * 64) : 0;
+            }
+
+            storeTile(tileRow * tilesPerRow + tileColumn, words);
+        }
+    }
+
+    data.shrink_to_fit();
+}
+
+void MazeTileStore::set(std::uint64_t row, std::uint64_t column, bool value)
+{
+    std::size_t tile = (row >> 6) * tilesPerRow + (column >> 6);
+
+    getTileWords(tile);
+
+    std::uint64_t* words = &cacheWords[cachedSlots[tile] * 64];
+
+    lastTile = tile;
+    lastWords = words;
+
+    std::uint64_t mask = std::uint64_t(1) << (column & 63);
+
+    if (((words[row & 63] & mask) != 0) == value)
+    {
+        return;
+    }
+
+    words[row & 63] ^= mask;
+
+    staleBytes += tileSizes[tile];
+    storeTile(tile, words);
+}
+
+//All tiles share one compressed uniform tile
+void MazeTileStore::fill(bool value)
+{
+    std::uint64_t words[64];
+    std::fill(words, words + 64, value ? ~std::uint64_t(0) : std::uint64_t(0));
+
+    data.clear();
+    encodeTile(words, data);
+    data.shrink_to_fit();
+
+    std::fill(tileOffsets.begin(), tileOffsets.end(), 0);
+    std::fill(tileSizes.begin(), tileSizes.end(), std::uint16_t(data.size()));
+    staleBytes = 0;
+
+    invalidateCache();
+}
+
+//Remove tiles that were replaced by writes
+void MazeTileStore::compact()
+{
+    if (staleBytes == 0)
+    {
+        return;
+    }
+
+    std::vector<std::uint8_t> compacted;
+    compacted.reserve(data.size() - std::min(staleBytes, data.size()));
+
+    for (std::size_t i = 0; i < tileOffsets.size(); i++)
+    {
+        std::uint64_t offset = tileOffsets[i];
+
+        tileOffsets[i] = compacted.size();
+        compacted.insert(compacted.end(), data.begin() + offset, data.begin() + offset + tileSizes[i]);
+    }
+
+    compacted.shrink_to_fit();
+    data.swap(compacted);
+    staleBytes = 0;
+}
+
+std::size_t MazeTileStore::getMemoryUsage() const
+{
+    return data.capacity() + tileOffsets.size() * sizeof(tileOffsets[0]) + tileSizes.size() * sizeof(tileSizes[0]) +
+           cacheWords.size() * sizeof(cacheWords[0]) + cacheTiles * (sizeof(slotTiles[0]) + sizeof(slotUses[0]));
+}
+
+std::string MazeTileStore::getStatistics() const
+{
+    return "compressed " + std::to_string(getCompressedBytes()) + " bytes in " + std::to_string(tileOffsets.size()) + " tiles, cached tiles " +
+           std::to_string(usedSlots) + " of " + std::to_string(cacheTiles) + ", cache hits " + std::to_string(cacheHits) +
+           ", misses " + std::to_string(cacheMisses);
+}
+
+std::uint64_t MazeTileStore::getCacheHits() const
+{
+    return cacheHits;
+}
+
+std::uint64_t MazeTileStore::getCacheMisses() const
+{
+    return cacheMisses;
+}
+
+//Get bytes of decompressed tiles currently held in cache
+std::size_t MazeTileStore::getCacheResidentBytes() const
+{
+    return usedSlots * 64 * sizeof(std::uint64_t);
+}
+
+std::size_t MazeTileStore::getCompressedBytes() const
+{
+    return data.size() - std::min(staleBytes, data.size());
+}
+
+//Find tile in cache or decompress it into least recently used slot
+const std::uint64_t* MazeTileStore::getTileWords(std::size_t tile) const
+{
+    std::size_t slot;
+    auto found = cachedSlots.find(tile);
+
+    if (found != cachedSlots.end())
+    {
+        slot = found->second;
+        cacheHits++;
+    }
+    else
+    {
+        if (usedSlots < cacheTiles)
+        {
+            slot = usedSlots++;
+        }
+        else
+        {
+            slot = std::min_element(slotUses.begin(), slotUses.end()) - slotUses.begin();
+            cachedSlots.erase(slotTiles[slot]);
+        }
+
+        slotTiles[slot] = tile;
+        cachedSlots[tile] = slot;
+
+        decodeTile(tile, &cacheWords[slot * 64]);
+        cacheMisses++;
+    }
+
+    slotUses[slot] = ++useCounter;
+
+    return &cacheWords[slot * 64];
+}
+
+void MazeTileStore::invalidateCache()
+{
+    std::fill(slotTiles.begin(), slotTiles.end(), NO_TILE);
+    std::fill(slotUses.begin(), slotUses.end(), 0);
+    cachedSlots.clear();
+
+    usedSlots = 0;
+    lastTile = NO_TILE;
+    lastWords = nullptr;
+}
+
+void MazeTileStore::encodeTile(const std::uint64_t* words, std::vector<std::uint8_t>& output) const
+{
+    unsigned int row = 0;
+
+    while (row < 64)
+    {
+        std::uint64_t bits = words[row];
+
+        if (row > 0 && bits == words[row - 1])
+        {
+            unsigned int repeats = 1;
+
+            while (row + repeats < 64 && words[row + repeats] == bits)
+            {
+                repeats++;
+            }
+
+            output.push_back(ROW_REPEAT);
+            output.push_back(std::uint8_t(repeats));
+
+            row += repeats;
+            continue;
+        }
+
+        //Set bit i of transitions means that field i+1 differs from field i (run ends at i)
+        std::uint64_t transitions = (bits ^ (bits >> 1)) & ~(std::uint64_t(1) << 63);
+        unsigned int runs = 1;
+
+        for (std::uint64_t rest = transitions; rest != 0 && runs <= MAX_RUNS; rest &= rest - 1)
+        {
+            runs++;
+        }
+
+        //Lattice row is used when run-length encoding would be longer than 5 bytes
+        bool lattice = (row & 1) ? (bits & ODD_BITS) == 0 : (bits & EVEN_BITS) == EVEN_BITS;
+
+        if (runs > 5 && lattice)
+        {
+            std::uint32_t walls = packEvenBits((row & 1) ? bits : bits >> 1);
+
+            output.push_back(ROW_LATTICE);
+
+            for (unsigned int i = 0; i < 4; i++)
+            {
+                output.push_back(std::uint8_t(walls >> (i * 8)));
+            }
+        }
+        else if (runs > MAX_RUNS)
+        {
+            output.push_back(ROW_RAW);
+
+            for (unsigned int i = 0; i < 8; i++)
+            {
+                output.push_back(std::uint8_t(bits >> (i * 8)));
+            }
+        }
+        else
+        {
+            output.push_back(std::uint8_t(((bits & 1) << 7) | runs));
+
+            int runEnd = -1;
+
+            for (; transitions != 0; transitions &= transitions - 1)
+            {
+                int position = countTrailingZeros(transitions);
+
+                output.push_back(std::uint8_t(position - runEnd));
+                runEnd = position;
+            }
+        }
+
+        row++;
+    }
+}
+
+void MazeTileStore::decodeTile(std::size_t tile, std::uint64_t* words) const
+{
+    const std::uint8_t* input = data.data() + tileOffsets[tile];
+    unsigned int row = 0;
+
+    while (row < 64)
+    {
+        std::uint8_t header = *input++;
+
+        if (header == ROW_RAW)
+        {
+            std::uint64_t bits = 0;
+
+            for (unsigned int i = 0; i < 8; i++)
+            {
+                bits |= std::uint64_t(*input++) << (i * 8);
+            }
+
+            words[row++] = bits;
+        }
+        else if (header == ROW_LATTICE)
+        {
+            std::uint32_t walls = 0;
+
+            for (unsigned int i = 0; i < 4; i++)
+            {
+                walls |= std::uint32_t(*input++) << (i * 8);
+            }
+
+            words[row] = (row & 1) ? spreadEvenBits(walls) : (spreadEvenBits(walls) << 1) | EVEN_BITS;
+            row++;
+        }
+        else if (header == ROW_REPEAT)
+        {
+            unsigned int repeats = *input++;
+
+            for (unsigned int i = 0; i < repeats; i++, row++)
+            {
+                words[row] = words[row - 1];
+            }
+        }
+        else
+        {
+            bool value = header >> 7;
+            unsigned int runs = header & 0x7F;
+            unsigned int position = 0;
+            std::uint64_t bits = 0;
+
+            for (unsigned int i = 0; i < runs; i++)
+            {
+                unsigned int length = (i == runs - 1) ? 64 - position : *input++;
+
+                if (value)
+                {
+                    bits |= (length == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << length) - 1) << position;
+                }
+
+                position += length;
+                value = !value;
+            }
+
+            words[row++] = bits;
+        }
+    }
+}
+
+//Compress tile and append it to data
+void MazeTileStore::storeTile(std::size_t tile, const std::uint64_t* words)
+{
+    std::size_t offset = data.size();
+
+    encodeTile(words, data);
+
+    tileOffsets[tile] = offset;
+    tileSizes[tile] = std::uint16_t(data.size() - offset);
+}
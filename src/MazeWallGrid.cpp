@@ -0,0 +1,71 @@
+#include "MazeWallGrid.hpp"
+
+#include <algorithm>
+
+//Size is array size (odd), there are (size - 1) / 2 maze fields in every row and column
+MazeWallGrid::MazeWallGrid(std::uint64_t size)
+{
+    std::uint64_t fields = (size - 1) / 2;
+
+    this->size = size;
+    stride = (fields + 31) / 32; //32 fields (two bits each) per word
+    words.assign(stride * fields, 0);
+
+    exitRow = 0;
+    exitColumn = 0;
+    exitOpen = false;
+}
+
+bool MazeWallGrid::get(std::uint64_t row, std::uint64_t column) const
+{
+    return isWall(row, column);
+}
+
+//Writes to maze fields and pillars are ignored because they are implied by lattice
+//Clearing border field opens exit
+void MazeWallGrid::set(std::uint64_t row, std::uint64_t column, bool value)
+{
+    if (row == 0 || column == 0 || row >= size - 1 || column >= size - 1)
+    {
+        if (!value)
+        {
+            exitRow = row;
+            exitColumn = column;
+            exitOpen = true;
+        }
+        else if (exitOpen && row == exitRow && column == exitColumn)
+        {
+            exitOpen = false;
+        }
+
+        return;
+    }
+
+    if ((row & 1) && !(column & 1))
+    {
+        setWall(row / 2, column / 2 - 1, Wall::EAST, value);
+    }
+    else if (!(row & 1) && (column & 1))
+    {
+        setWall(row / 2 - 1, column / 2, Wall::SOUTH, value);
+    }
+}
+
+void MazeWallGrid::fill(bool value)
+{
+    std::fill(words.begin(), words.end(), value ? ~std::uint64_t(0) : std::uint64_t(0));
+    exitOpen = false;
+}
+
+std::size_t MazeWallGrid::getMemoryUsage() const
+{
+    return words.size() * sizeof(std::uint64_t);
+}
+
+void MazeWallGrid::setWall(std::uint64_t fieldRow, std::uint64_t fieldColumn, Wall wall, bool value)
+{
+    std::uint64_t& word = words[fieldRow * stride + (fieldColumn >> 5)];
+    std::uint64_t mask = std::uint64_t(1) << ((fieldColumn & 31) * 2 + wall);
+
+    word = (word & ~mask) | ((std::uint64_t(0) - std::uint64_t(value)) & mask);
+}
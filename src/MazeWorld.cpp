@@ -0,0 +1,221 @@
+#include "MazeWorld.hpp"
+
+#include <algorithm>
+
+static const std::uint64_t NO_CHUNK = ~std::uint64_t(0); //Chunk coordinates fit 31 bits, so it's never valid key
+static const std::uint64_t CHUNK_CELLS = 32; //Cells in row and column of chunk (cell i is local field 2 * i + 1)
+
+MazeWorld::MazeWorld(std::uint64_t seed, std::uint64_t radius)
+: seed(seed), radius(radius)
+{
+    centerRow = 0;
+    centerColumn = 0;
+    hasCenter = false;
+    generatedChunks = 0;
+    evictedChunks = 0;
+    lastChunk = NO_CHUNK;
+    lastWords = nullptr;
+
+    //Before eviction chunks can be one chunk further from center than resident radius
+    std::size_t slots = (2 * radius + 3) * (2 * radius + 3);
+
+    chunkWords.resize(slots * CHUNK_FIELDS);
+    freeSlots.reserve(slots);
+
+    for (std::size_t i = slots; i > 0; i--)
+    {
+        freeSlots.push_back(i - 1);
+    }
+
+    chunkSlots.reserve(slots);
+}
+
+//Writes only change resident chunks, they are lost when chunk is evicted
+void MazeWorld::set(std::uint64_t row, std::uint64_t column, bool value)
+{
+    if (row >= WORLD_SIZE || column >= WORLD_SIZE)
+    {
+        return;
+    }
+
+    auto slot = chunkSlots.find(getChunkKey(row / CHUNK_FIELDS, column / CHUNK_FIELDS));
+
+    if (slot == chunkSlots.end())
+    {
+        return;
+    }
+
+    std::uint64_t& word = chunkWords[slot->second * CHUNK_FIELDS + row % CHUNK_FIELDS];
+    std::uint64_t mask = std::uint64_t(1) << (column % CHUNK_FIELDS);
+
+    word = (word & ~mask) | ((std::uint64_t(0) - std::uint64_t(value)) & mask);
+}
+
+void MazeWorld::fill(bool value)
+{
+    for (const auto& slot : chunkSlots)
+    {
+        std::fill_n(chunkWords.begin() + slot.second * CHUNK_FIELDS, CHUNK_FIELDS, value ? ~std::uint64_t(0) : std::uint64_t(0));
+    }
+}
+
+std::size_t MazeWorld::getMemoryUsage() const
+{
+    return chunkWords.size() * sizeof(std::uint64_t) + freeSlots.capacity() * sizeof(std::size_t) +
+           chunkSlots.bucket_count() * sizeof(void*) + chunkSlots.size() * (sizeof(std::uint64_t) + sizeof(std::size_t) + sizeof(void*));
+}
+
+std::string MazeWorld::getStatistics() const
+{
+    return "resident chunks " + std::to_string(chunkSlots.size()) + ", generated " + std::to_string(generatedChunks) +
+           ", evicted " + std::to_string(evictedChunks);
+}
+
+void MazeWorld::update(std::uint64_t row, std::uint64_t column)
+{
+    if (row >= WORLD_SIZE || column >= WORLD_SIZE)
+    {
+        return;
+    }
+
+    std::uint64_t chunkRow = row / CHUNK_FIELDS;
+    std::uint64_t chunkColumn = column / CHUNK_FIELDS;
+
+    if (hasCenter && chunkRow == centerRow && chunkColumn == centerColumn)
+    {
+        return;
+    }
+
+    centerRow = chunkRow;
+    centerColumn = chunkColumn;
+    hasCenter = true;
+    lastChunk = NO_CHUNK;
+
+    //Evict chunks behind, one more ring stays resident so walking along chunk border doesn't generate the same chunks again
+    for (auto slot = chunkSlots.begin(); slot != chunkSlots.end();)
+    {
+        std::uint64_t slotRow = slot->first >> 32;
+        std::uint64_t slotColumn = slot->first & 0xFFFFFFFF;
+        std::uint64_t distance = std::max(std::max(slotRow, chunkRow) - std::min(slotRow, chunkRow),
+                                          std::max(slotColumn, chunkColumn) - std::min(slotColumn, chunkColumn));
+
+        if (distance > radius + 1)
+        {
+            freeSlots.push_back(slot->second);
+            slot = chunkSlots.erase(slot);
+            evictedChunks++;
+        }
+        else
+        {
+            slot++;
+        }
+    }
+
+    std::uint64_t lastChunkIndex = WORLD_SIZE / CHUNK_FIELDS - 1;
+
+    for (std::uint64_t loadRow = chunkRow - std::min(chunkRow, radius); loadRow <= std::min(chunkRow + radius, lastChunkIndex); loadRow++)
+    {
+        for (std::uint64_t loadColumn = chunkColumn - std::min(chunkColumn, radius); loadColumn <= std::min(chunkColumn + radius, lastChunkIndex); loadColumn++)
+        {
+            std::uint64_t key = getChunkKey(loadRow, loadColumn);
+
+            if (chunkSlots.count(key) != 0)
+            {
+                continue;
+            }
+
+            std::size_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            chunkSlots.emplace(key, slot);
+
+            generateChunk(loadRow, loadColumn, &chunkWords[slot * CHUNK_FIELDS]);
+            generatedChunks++;
+        }
+    }
+}
+
+std::size_t MazeWorld::getResidentChunks() const
+{
+    return chunkSlots.size();
+}
+
+std::uint64_t MazeWorld::getGeneratedChunks() const
+{
+    return generatedChunks;
+}
+
+//Generate chunk only from seed and its coordinates, so it's the same whenever it's generated again
+//Top wall row and left wall column have one opening each, right and bottom walls belong to neighbours, which choose their openings the same way
+//Interior is recursive division of 32x32 cells (iterative with stack of packed chambers)
+void MazeWorld::generateChunk(std::uint64_t chunkRow, std::uint64_t chunkColumn, std::uint64_t* words)
+{
+    MazeRandom stream(seed, getChunkKey(chunkRow, chunkColumn));
+    std::uint64_t topOpening = 2 * (stream.next() % CHUNK_CELLS) + 1;
+    std::uint64_t leftOpening = 2 * (stream.next() % CHUNK_CELLS) + 1;
+    MazeSequentialRandom random(stream);
+
+    //Border of world is closed
+    words[0] = chunkRow == 0 ? ~std::uint64_t(0) : ~(std::uint64_t(1) << topOpening);
+
+    for (std::uint64_t i = 1; i < CHUNK_FIELDS; i++)
+    {
+        words[i] = 1;
+    }
+
+    if (chunkColumn != 0)
+    {
+        words[leftOpening] = 0;
+    }
+
+    //Chamber is start column, start row, end column and end row of cells (8 bits each)
+    chambers.clear();
+    chambers.push_back((CHUNK_CELLS - 1) << 16 | (CHUNK_CELLS - 1) << 24);
+
+    while (!chambers.empty())
+    {
+        std::uint64_t chamber = chambers.back();
+        chambers.pop_back();
+
+        std::uint64_t startX = chamber & 0xFF;
+        std::uint64_t startY = (chamber >> 8) & 0xFF;
+        std::uint64_t endX = (chamber >> 16) & 0xFF;
+        std::uint64_t endY = (chamber >> 24) & 0xFF;
+        std::uint64_t width = endX - startX;
+        std::uint64_t height = endY - startY;
+
+        if (width < 1 || height < 1)
+        {
+            continue;
+        }
+
+        bool horizontal = width < height || (width == height && (random.next() >> 63));
+
+        if (horizontal)
+        {
+            std::uint64_t wallField = startY + random.getBounded32(height);
+            std::uint64_t passageField = startX + random.getBounded32(width + 1);
+            std::uint64_t wallMask = (~std::uint64_t(0) >> (63 - 2 * width)) << (2 * startX + 1);
+
+            words[wallField * 2 + 2] |= wallMask & ~(std::uint64_t(1) << (passageField * 2 + 1));
+
+            chambers.push_back(startX | (wallField + 1) << 8 | endX << 16 | endY << 24);
+            chambers.push_back(startX | startY << 8 | endX << 16 | wallField << 24);
+        }
+        else
+        {
+            std::uint64_t wallField = startX + random.getBounded32(width);
+            std::uint64_t passageField = startY + random.getBounded32(height + 1);
+            std::uint64_t wallBit = std::uint64_t(1) << (wallField * 2 + 2);
+
+            for (std::uint64_t i = startY * 2 + 1; i <= endY * 2 + 1; i++)
+            {
+                words[i] |= wallBit;
+            }
+
+            words[passageField * 2 + 1] &= ~wallBit;
+
+            chambers.push_back((wallField + 1) | startY << 8 | endX << 16 | endY << 24);
+            chambers.push_back(startX | startY << 8 | wallField << 16 | endY << 24);
+        }
+    }
+}
@@ -1,4 +1,6 @@
 #include <SDL.h>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -7,13 +9,17 @@
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include <atomic>
+#include <thread>
 
 #include "MazeGenerator.hpp"
+#include "MazeFaceMask.hpp"
+#include "MazeWallGrid.hpp"
 #include "SDL_stdinc.h"
 #include "SDL_surface.h"
 #include "ShaderManager.hpp"
-#include "MazeGeneratorDFS.hpp"
-#include "MazeGeneratorRD.hpp"
+#include "MazeGeneratorRegistry.hpp"
+#include "MazeWorld.hpp"
 
 #include "mini/ini.h"
 #define STB_IMAGE_IMPLEMENTATION
@@ -25,14 +31,16 @@
     #define PATH_SEPARATOR "/"
 #endif
 
-//Available maze generators
-enum Generator { DFS, RD };
-
-int windowWidth, windowHeight, mazeSize;
+int windowWidth, windowHeight;
+std::uint64_t mazeSize;
+unsigned int generatorThreads; //0 means serial generation
 bool enableCollisions, setFullscreen, setPortable, mouseEnabled;
-std::string mazeSeed;
+bool slicedGeneration; //Generate maze in time slices of loading screen frames instead of background thread
+std::string mazeSeed, mazeFile;
+std::uint64_t memoryBudget; //Bytes that AUTO generator can use, 0 means unlimited
 
-Generator selectedGenerator;
+std::string selectedGenerator; //Name of registered generator with optional parameters after colon, or "AUTO"
+MazeGenerator::Storage selectedStorage;
 
 struct StbImage
 {
@@ -54,11 +62,13 @@ bool checkCollisionPointReactangle(float pointX, float pointY, float wallX, floa
 }
 
 //Check collision between player and map
-bool checkCollision(float positionX, float positionZ, bool** mazeArray, int mazeSize)
+//Player position is relative to origin (originX, originZ), so float precision doesn't depend on maze size
+//WALLS storage is read directly from wall bits (wallGrid is nullptr with other storages)
+bool checkCollision(float positionX, float positionZ, std::int64_t originX, std::int64_t originZ, const MazeGridView& mazeArray, const MazeWallGrid* wallGrid, std::int64_t mazeSize)
 {
     //Get player location (map array indices) in maze array
-    int startRow = positionZ;
-    int startColumn = positionX;
+    std::int64_t startRow = originZ + (std::int64_t)std::floor(positionZ);
+    std::int64_t startColumn = originX + (std::int64_t)std::floor(positionX);
 
     bool collide = false;
 
@@ -67,17 +77,19 @@ bool checkCollision(float positionX, float positionZ, bool** mazeArray, int maze
     startColumn -= 2;
 
     //If start indices are less than 0, use 0 instead
-    startRow = std::max(startRow, 0);
-    startColumn = std::max(startColumn, 0);
+    startRow = std::max<std::int64_t>(startRow, 0);
+    startColumn = std::max<std::int64_t>(startColumn, 0);
 
     //Go through maze array starting from calculated position and ending by calculated position + 4
     //If ending position is bigger than maze size then pick maze size
-    for (int i = startRow; i < std::min(startRow + 4, mazeSize); i++)
+    for (std::int64_t i = startRow; i < std::min(startRow + 4, mazeSize); i++)
     {
-        for (int j =  startColumn; j < std::min(startColumn + 4, mazeSize); j++)
+        for (std::int64_t j =  startColumn; j < std::min(startColumn + 4, mazeSize); j++)
         {
             //Collision occurs when player is on non empty field (true in maze array)
-            if (mazeArray[i][j] && checkCollisionPointReactangle(positionX, positionZ, j*1.0f, i*1.0f))
+            bool isWall = wallGrid != nullptr ? wallGrid->isWall(i, j) : mazeArray.get(i, j);
+
+            if (isWall && checkCollisionPointReactangle(positionX, positionZ, (j - originX)*1.0f, (i - originZ)*1.0f))
             {
                 collide = true;
                 break; //If collision happened then stop checking, there is no need to check further
@@ -126,6 +138,9 @@ void parseConfigFile(std::string configFileLocation)
         iniStructure["Config"]["Size"] = "20";
         iniStructure["Config"]["Collisions"] = "1";
         iniStructure["Config"]["Generator"] = "RD";
+        iniStructure["Config"]["Storage"] = "BITS";
+        iniStructure["Config"]["Threads"] = "0";
+        iniStructure["Config"]["MemoryBudget"] = "0";
         iniStructure["Config"]["mouse"] = "1";
 
 
@@ -137,14 +152,15 @@ void parseConfigFile(std::string configFileLocation)
     
     if (configFile.read(iniStructure)) //Try to load existing config file
 	{
-		int width = -1, height = -1, size = -1, fullscreen = -1, collisions = -1, mouse = -1;
-        std::string generator;
+		int width = -1, height = -1, fullscreen = -1, collisions = -1, mouse = -1;
+        long long size = -1, threads = 0, budget = 0;
+        std::string generator, storage;
 
 		try
 		{
             width = std::stoi(iniStructure["Config"]["Width"]);
             height = std::stoi(iniStructure["Config"]["Height"]);
-            size = std::stoi(iniStructure["Config"]["Size"]);
+            size = std::stoll(iniStructure["Config"]["Size"]);
 
             fullscreen = std::stoi(iniStructure["Config"]["Fullscreen"]);
             collisions = std::stoi(iniStructure["Config"]["Collisions"]);
@@ -152,6 +168,18 @@ void parseConfigFile(std::string configFileLocation)
             mouse = std::stoi(iniStructure["Config"]["mouse"]);
 
             generator = iniStructure["Config"]["Generator"];
+            storage = iniStructure["Config"]["Storage"];
+
+            //Older config files don't have this key
+            if (iniStructure["Config"].has("Threads"))
+            {
+                threads = std::stoll(iniStructure["Config"]["Threads"]);
+            }
+
+            if (iniStructure["Config"].has("MemoryBudget"))
+            {
+                budget = std::stoll(iniStructure["Config"]["MemoryBudget"]);
+            }
 		}
 		catch (...)
 		{
@@ -174,7 +202,7 @@ void parseConfigFile(std::string configFileLocation)
         windowWidth = width;
         windowHeight = height;
 
-        if (size < 10 || size > 100000)
+        if (size < 10)
         {
             mazeSize = 20;
         }
@@ -198,13 +226,37 @@ void parseConfigFile(std::string configFileLocation)
             mouseEnabled = false;
         }
 
-        if (generator == "RD")
+        //Generator name is checked against registry when generator is created
+        if (!generator.empty())
+        {
+            selectedGenerator = generator;
+        }
+
+        if (storage == "BITS")
+        {
+            selectedStorage = MazeGenerator::Storage::BITS;
+        }
+        else if (storage == "WALLS")
+        {
+            selectedStorage = MazeGenerator::Storage::WALLS;
+        }
+        else if (storage == "CHUNKED")
+        {
+            selectedStorage = MazeGenerator::Storage::CHUNKED;
+        }
+        else if (storage == "COMPRESSED")
+        {
+            selectedStorage = MazeGenerator::Storage::COMPRESSED;
+        }
+
+        if (threads >= 0 && threads <= 1024)
         {
-            selectedGenerator = Generator::RD;
+            generatorThreads = threads;
         }
-        else if (generator == "DFS")
+
+        if (budget > 0)
         {
-            selectedGenerator = Generator::DFS;
+            memoryBudget = std::uint64_t(budget) * 1024 * 1024;
         }
 	}
 }
@@ -253,18 +305,18 @@ void parseArguments(std::vector<std::string> arguments)
         {
             std::string sizestr = argument.substr(6, argument.size());
             
-            int size;
+            long long size;
 
             try
             {
-                size = std::stoi(sizestr);
+                size = std::stoll(sizestr);
             }
             catch(...)
             {
                 size = 0;
             }
 
-            if (size < 10 || size > 100000)
+            if (size < 10)
             {
                 mazeSize = 20;
             }
@@ -276,16 +328,71 @@ void parseArguments(std::vector<std::string> arguments)
 
         if (argument.find("-generator=") != std::string::npos && argument.size() > 11)
         {
-            std::string generatorString = argument.substr(11, argument.size());
-            
-            if (generatorString == "DFS")
+            selectedGenerator = argument.substr(11, argument.size());
+        }
+
+        if (argument.find("-storage=") != std::string::npos && argument.size() > 9)
+        {
+            std::string storageString = argument.substr(9, argument.size());
+
+            if (storageString == "WALLS")
+            {
+                selectedStorage = MazeGenerator::Storage::WALLS;
+            }
+            else if (storageString == "CHUNKED")
+            {
+                selectedStorage = MazeGenerator::Storage::CHUNKED;
+            }
+            else if (storageString == "COMPRESSED")
             {
-                selectedGenerator = Generator::DFS;
+                selectedStorage = MazeGenerator::Storage::COMPRESSED;
             }
             else
             {
-                selectedGenerator = Generator::RD;
+                selectedStorage = MazeGenerator::Storage::BITS;
+            }
+        }
+
+        if (argument.find("-maze-file=") != std::string::npos && argument.size() > 11)
+        {
+            mazeFile = argument.substr(11, argument.size());
+        }
+
+        if (argument.find("-threads=") != std::string::npos && argument.size() > 9)
+        {
+            long long threads;
+
+            try
+            {
+                threads = std::stoll(argument.substr(9, argument.size()));
+            }
+            catch(...)
+            {
+                threads = 0;
+            }
+
+            if (threads < 0 || threads > 1024)
+            {
+                threads = 0;
+            }
+
+            generatorThreads = threads;
+        }
+
+        if (argument.find("-memory-budget=") != std::string::npos && argument.size() > 15)
+        {
+            long long budget;
+
+            try
+            {
+                budget = std::stoll(argument.substr(15, argument.size()));
             }
+            catch(...)
+            {
+                budget = 0;
+            }
+
+            memoryBudget = budget > 0 ? std::uint64_t(budget) * 1024 * 1024 : 0;
         }
 
         if (argument.find("-seed=") != std::string::npos && argument.size() > 6)
@@ -309,6 +416,11 @@ void parseArguments(std::vector<std::string> arguments)
         {
             mouseEnabled = false;
         }
+
+        if (argument.find("-sliced-generation") != std::string::npos)
+        {
+            slicedGeneration = true;
+        }
     }
 
     //Set correct resolution (only for window, full screen uses native resolution)
@@ -372,12 +484,17 @@ int main(int argc, char* argv[])
     windowWidth = 800;
     windowHeight = 600;
     mazeSize = 20;
+    generatorThreads = 0;
     enableCollisions = true;
     setFullscreen = false;
     setPortable = false;
     mouseEnabled = true;
+    slicedGeneration = false;
     mazeSeed = "";
-    selectedGenerator = Generator::RD; //Recursive division maze generator
+    mazeFile = "";
+    memoryBudget = 0;
+    selectedGenerator = "RD"; //Recursive division maze generator
+    selectedStorage = MazeGenerator::Storage::BITS; //One bit per maze field
 
     std::string prefPath;
 
@@ -443,30 +560,140 @@ int main(int argc, char* argv[])
         std::cout << "Generator seed: " << mazeSeed << std::endl;
     }
 
-    std::cout << "Maze generator: ";
+    MazeGeneratorRegistry& registry = MazeGeneratorRegistry::getInstance();
+
+    //AUTO selects fastest generator and storage that fit into memory budget
+    if (selectedGenerator == "AUTO")
+    {
+        MazeGenerator::Storage autoStorage;
+        const MazeGeneratorInfo* autoInfo = registry.selectFastest(mazeSize, memoryBudget, std::max(generatorThreads, 1u), autoStorage);
+
+        if (memoryBudget != 0 && autoInfo->estimateMemory(mazeSize, autoStorage) > memoryBudget)
+        {
+            std::cout << "No generator fits into memory budget, using the one with the smallest memory estimate" << std::endl;
+        }
+
+        selectedGenerator = autoInfo->name;
+        selectedStorage = autoStorage;
+    }
+
+    std::string generatorName, generatorParameters;
+    MazeGeneratorRegistry::splitName(selectedGenerator, generatorName, generatorParameters);
 
-    bool** mazeArray;
-    MazeGenerator* mazeGenerator;
+    const MazeGeneratorInfo* generatorInfo = registry.find(generatorName);
 
-    switch (selectedGenerator)
+    if (generatorInfo == nullptr)
     {
-        case Generator::DFS:
-            std::cout << "DFS" << std::endl;
+        std::cout << "Unknown maze generator " << generatorName << ", available generators:" << std::endl;
 
-            mazeGenerator = new MazeGeneratorDFS(mazeSize, mazeSeed);
+        for (const MazeGeneratorInfo& info : registry.getGenerators())
+        {
+            std::cout << "    " << info.name << " - " << info.description << (info.parameters.empty() ? "" : " (parameters: " + info.parameters + ")") << std::endl;
+        }
 
-            break;
+        std::cout << "    AUTO - fastest generator for maze size, threads and memory budget" << std::endl;
 
-        default:
-            std::cout << "RD" << std::endl;
+        generatorName = "RD";
+        generatorParameters = "";
+        generatorInfo = registry.find(generatorName);
+    }
 
-            mazeGenerator = new MazeGeneratorRD(mazeSize, mazeSeed);
+    MazeGenerator* mazeGenerator = registry.create(generatorName + (generatorParameters.empty() ? "" : ":" + generatorParameters), mazeSize, mazeSeed);
 
-            break;
+    if (mazeGenerator == nullptr)
+    {
+        std::cout << "Invalid parameters of maze generator " << generatorName << ", using defaults" << std::endl;
+
+        generatorParameters = "";
+        mazeGenerator = registry.create(generatorName, mazeSize, mazeSeed);
+    }
+
+    std::cout << "Maze generator: " << generatorName << (generatorParameters.empty() ? "" : ":" + generatorParameters) << std::endl;
+
+    bool parallelGeneration = false;
+
+    //Endless maze has its own storage of chunks around player and it's generated in one thread
+    if (generatorInfo->hasCapability(MazeGeneratorInfo::ENDLESS))
+    {
+        std::cout << "Maze storage: chunks of " << MazeWorld::CHUNK_FIELDS << "x" << MazeWorld::CHUNK_FIELDS << " fields around player" << std::endl;
+    }
+    else
+    {
+        if (!mazeGenerator->setStorage(selectedStorage))
+        {
+            std::cout << "Selected maze storage is not supported by this generator, using BITS" << std::endl;
+        }
+
+        const char* storageNames[] = { "BITS", "WALLS", "CHUNKED", "COMPRESSED" };
+
+        std::cout << "Maze storage: " << storageNames[mazeGenerator->getStorage()] << std::endl;
+
+        if (generatorThreads > 0)
+        {
+            if (mazeGenerator->setThreads(generatorThreads))
+            {
+                parallelGeneration = true;
+
+                std::cout << "Generator threads: " << generatorThreads << std::endl;
+            }
+            else
+            {
+                std::cout << "Parallel generation is not supported by this generator or storage, using one thread" << std::endl;
+            }
+        }
+
+        if (!mazeFile.empty())
+        {
+            if (mazeGenerator->getStorage() == MazeGenerator::Storage::BITS)
+            {
+                std::cout << "Maze file: " << mazeFile << std::endl;
+
+                mazeGenerator->setMazeFile(mazeFile);
+            }
+            else
+            {
+                std::cout << "Maze file is used only with BITS storage" << std::endl;
+            }
+        }
+    }
+
+    //Maze is generated in background while window, shaders and textures are created, loading screen shows its progress
+    //Sliced generation runs on main thread in steps between frames of loading screen
+    std::atomic<bool> generationFinished(false);
+    std::thread generatorThread;
+
+    //Generator that can't resume would generate whole maze in the first slice and freeze loading screen
+    if (slicedGeneration && (!generatorInfo->hasCapability(MazeGeneratorInfo::RESUMABLE) || parallelGeneration))
+    {
+        std::cout << "Sliced generation needs resumable generator in one thread, using background thread" << std::endl;
+
+        slicedGeneration = false;
+    }
+
+    if (slicedGeneration)
+    {
+        std::cout << "Maze is generated in slices on main thread" << std::endl;
     }
+    else
+    {
+        generatorThread = std::thread([mazeGenerator, &generationFinished]()
+        {
+            mazeGenerator->generateMaze();
+            mazeGenerator->compactArray();
 
-    mazeGenerator->generateMaze();
-    mazeArray = mazeGenerator->getMazeArray();
+            generationFinished = true;
+        });
+    }
+
+    //Generator has to be stopped before main returns, otherwise running thread terminates program
+    auto stopGenerator = [mazeGenerator, &generatorThread]()
+    {
+        if (generatorThread.joinable())
+        {
+            mazeGenerator->cancel();
+            generatorThread.join();
+        }
+    };
 
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE); //Set OpenGL context to OpenGL 3.3 Core Profile
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
@@ -483,6 +710,7 @@ int main(int argc, char* argv[])
     if (mainWindow == nullptr)
     {
         std::cout << "Failed creating SDL Window!" << std::endl;
+        stopGenerator();
         return EXIT_FAILURE;
     }
     
@@ -491,6 +719,7 @@ int main(int argc, char* argv[])
     if (glContext == nullptr) 
     {
         std::cout << "Error creating OpenGL context!" << std::endl;
+        stopGenerator();
         return EXIT_FAILURE;
     }
 
@@ -498,6 +727,7 @@ int main(int argc, char* argv[])
     if(!gladLoadGLLoader(SDL_GL_GetProcAddress))
     {
         std::cerr << "Failed initializing GLAD!" << std::endl;
+        stopGenerator();
         return EXIT_FAILURE;
     }
 
@@ -553,6 +783,7 @@ int main(int argc, char* argv[])
                             (installDir + "shaders" + PATH_SEPARATOR +  "fragmentshader.frag").c_str()))
     {
         std::cerr << "Failed loading shaders!" << std::endl;
+        stopGenerator();
         return EXIT_FAILURE;
     }
 
@@ -566,6 +797,7 @@ int main(int argc, char* argv[])
     if (wallImage.pixels == nullptr || floorImage.pixels == nullptr || ceilingImage.pixels == nullptr || exitImage.pixels == nullptr)
     {
         std::cerr << "Failed loading assets!" << std::endl;
+        stopGenerator();
         return EXIT_FAILURE;
     }
 
@@ -607,6 +839,105 @@ int main(int argc, char* argv[])
     stbi_image_free(ceilingImage.pixels);
     stbi_image_free(exitImage.pixels);
 
+    //Enable vsync
+    SDL_GL_SetSwapInterval(1);
+
+    SDL_Event windowEvent;
+    bool isRunning = true;
+
+    //Loading screen until maze is generated, closing window or escape cancels generation and skips game
+    //Progress bar is drawn only by clearing scissor rectangles, so it doesn't need shaders or buffers
+    int shownPercent = -1;
+
+    while (!generationFinished && isRunning)
+    {
+        while (SDL_PollEvent(&windowEvent))
+        {
+            if (windowEvent.type == SDL_QUIT || (windowEvent.type == SDL_KEYDOWN && windowEvent.key.keysym.scancode == SDL_SCANCODE_ESCAPE))
+            {
+                isRunning = false;
+            }
+        }
+
+        //Slice leaves half of 60 Hz frame for drawing and events
+        if (slicedGeneration && mazeGenerator->stepFor(std::chrono::milliseconds(8)))
+        {
+            mazeGenerator->compactArray();
+            generationFinished = true;
+        }
+
+        double progress = mazeGenerator->getProgress();
+        int percent = int(progress * 100.0);
+
+        if (percent != shownPercent)
+        {
+            SDL_SetWindowTitle(mainWindow, ("glMaze - generating maze " + std::to_string(percent) + "%").c_str());
+            shownPercent = percent;
+        }
+
+        int barWidth = windowWidth / 2;
+        int barHeight = std::max(8, windowHeight / 30);
+        int barX = (windowWidth - barWidth) / 2;
+        int barY = (windowHeight - barHeight) / 2;
+
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        glEnable(GL_SCISSOR_TEST);
+
+        glScissor(barX, barY, barWidth, barHeight);
+        glClearColor(0.25f, 0.25f, 0.25f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glScissor(barX, barY, int(barWidth * progress), barHeight);
+        glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glDisable(GL_SCISSOR_TEST);
+
+        SDL_GL_SwapWindow(mainWindow);
+
+        if (!slicedGeneration)
+        {
+            SDL_Delay(10); //Leave time to generator if vsync is not available
+        }
+    }
+
+    if (!isRunning)
+    {
+        std::cout << "Maze generation cancelled" << std::endl;
+        stopGenerator();
+    }
+    else if (generatorThread.joinable())
+    {
+        generatorThread.join();
+    }
+
+    SDL_SetWindowTitle(mainWindow, "glMaze");
+
+    MazeGridView mazeArray = mazeGenerator->getMazeArray();
+
+    if (isRunning)
+    {
+        std::cout << "Maze memory usage: " << mazeGenerator->getMemoryUsage() / (1024 * 1024) << " MiB" << std::endl;
+
+        if (!mazeGenerator->getStorageStatistics().empty())
+        {
+            std::cout << "Maze storage statistics: " << mazeGenerator->getStorageStatistics() << std::endl;
+        }
+    }
+
+    //Precompute visible wall faces, for other storages or huge mazes faces are computed from maze array while rendering
+    const MazeWallGrid* wallGrid = mazeGenerator->getWallGrid();
+    MazeFaceMask faceMask(mazeArray, mazeGenerator->getEndY(), mazeGenerator->getEndX(), wallGrid);
+
+    if (isRunning && mazeGenerator->getStorage() == MazeGenerator::Storage::BITS && mazeGenerator->getMazeSize() <= MazeFaceMask::MAX_BUILD_SIZE)
+    {
+        faceMask.build();
+
+        std::cout << "Face mask memory usage: " << faceMask.getMemoryUsage() / (1024 * 1024) << " MiB" << std::endl;
+    }
+
     //Set model, view and projection matrices
     glm::mat4 model = glm::mat4(1.0f);
     glm::mat4 view = glm::mat4(1.0f);
@@ -615,7 +946,13 @@ int main(int argc, char* argv[])
     projection = glm::perspective(glm::radians(45.0f), (float)windowWidth / (float)windowHeight, 0.1f, 100.0f);
 
     //Setup camera matrices
-    glm::vec3 cameraPosition   = glm::vec3(mazeGenerator->getStartX()*1.0f, 0.0f, mazeGenerator->getStartY()*1.0f);
+    //Camera position is kept relative to origin field, origin follows player so floats stay precise even in huge mazes
+    //All rendering is done in the same origin relative space
+    std::int64_t originX = mazeGenerator->getStartX();
+    std::int64_t originZ = mazeGenerator->getStartY();
+    std::int64_t mazeSizeSigned = mazeGenerator->getMazeSize();
+
+    glm::vec3 cameraPosition   = glm::vec3(0.0f, 0.0f, 0.0f);
     glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
     glm::vec3 cameraUp    = glm::vec3(0.0f, 1.0f,  0.0f);
 
@@ -623,9 +960,6 @@ int main(int argc, char* argv[])
 
     view = glm::lookAt(cameraPosition, cameraPosition + cameraFront, cameraUp);
 
-    //Enable vsync
-    SDL_GL_SetSwapInterval(1);
-
     //Grab mouse for camera if mouse control is enabled
     if (mouseEnabled)
     {
@@ -633,9 +967,6 @@ int main(int argc, char* argv[])
         SDL_CaptureMouse(SDL_TRUE);
     }
 
-    SDL_Event windowEvent;
-    bool isRunning = true;
-
     float deltaTime, lastFrame, currentFrame, cameraSpeed, movementSpeed;
     lastFrame = SDL_GetTicks()*0.001f;
     deltaTime = lastFrame;
@@ -689,7 +1020,7 @@ int main(int argc, char* argv[])
 
             cameraPosition.x += movementSpeed * cameraFront.x; //Move x position
 
-            if (enableCollisions && checkCollision(cameraPosition.x, cameraPosition.z, mazeArray, mazeGenerator->getMazeSize()))
+            if (enableCollisions && checkCollision(cameraPosition.x, cameraPosition.z, originX, originZ, mazeArray, wallGrid, mazeSizeSigned))
             {
                 cameraPosition = lastPosition; //Revert position if collision happened
             }
@@ -698,7 +1029,7 @@ int main(int argc, char* argv[])
 
             cameraPosition.z += movementSpeed * cameraFront.z; //Move z position
 
-            if (enableCollisions && checkCollision(cameraPosition.x, cameraPosition.z, mazeArray, mazeGenerator->getMazeSize()))
+            if (enableCollisions && checkCollision(cameraPosition.x, cameraPosition.z, originX, originZ, mazeArray, wallGrid, mazeSizeSigned))
             {
                 cameraPosition = lastPosition; //Same as before
             }
@@ -710,7 +1041,7 @@ int main(int argc, char* argv[])
 
             cameraPosition.x -= movementSpeed * cameraFront.x;
 
-            if (enableCollisions && checkCollision(cameraPosition.x, cameraPosition.z, mazeArray, mazeGenerator->getMazeSize()))
+            if (enableCollisions && checkCollision(cameraPosition.x, cameraPosition.z, originX, originZ, mazeArray, wallGrid, mazeSizeSigned))
             {
                 cameraPosition = lastPosition;
             }
@@ -719,7 +1050,7 @@ int main(int argc, char* argv[])
 
             cameraPosition.z -= movementSpeed * cameraFront.z;
 
-            if (enableCollisions && checkCollision(cameraPosition.x, cameraPosition.z, mazeArray, mazeGenerator->getMazeSize()))
+            if (enableCollisions && checkCollision(cameraPosition.x, cameraPosition.z, originX, originZ, mazeArray, wallGrid, mazeSizeSigned))
             {
                 cameraPosition = lastPosition;
             }
@@ -741,8 +1072,24 @@ int main(int argc, char* argv[])
             isRunning = false;
         }
 
+        //Move origin to player if player walked too far from it
+        if (std::fabs(cameraPosition.x) > 16.0f || std::fabs(cameraPosition.z) > 16.0f)
+        {
+            std::int64_t shiftX = (std::int64_t)std::floor(cameraPosition.x);
+            std::int64_t shiftZ = (std::int64_t)std::floor(cameraPosition.z);
+
+            originX += shiftX;
+            originZ += shiftZ;
+
+            cameraPosition.x -= shiftX;
+            cameraPosition.z -= shiftZ;
+        }
+
+        //Endless maze generates chunks player walks to before they are checked for collisions or drawn
+        mazeGenerator->updatePosition(originZ + (std::int64_t)std::floor(cameraPosition.z), originX + (std::int64_t)std::floor(cameraPosition.x));
+
         //End game if player is near to exit
-        if (checkCollisionPointReactangle(cameraPosition.x, cameraPosition.z, mazeGenerator->getEndX(), mazeGenerator->getEndY()))
+        if (checkCollisionPointReactangle(cameraPosition.x, cameraPosition.z, (std::int64_t(mazeGenerator->getEndX()) - originX)*1.0f, (std::int64_t(mazeGenerator->getEndY()) - originZ)*1.0f))
         {
             isRunning = false;
         }
@@ -788,32 +1135,37 @@ int main(int argc, char* argv[])
         //Only small area around player needs to be drawn so there is no need to check whole array every time
         //Calculate starting and ending row/column from actual player position
         //Rendering will be fast no matter how big array will be because we check and render small part of array
-        int startRow = std::max(1, (int)cameraPosition.z - 15);
-        int startColumn = std::max(1, (int)cameraPosition.x - 15);
-        int endRow = std::min((int)mazeGenerator->getMazeSize() - 1, (int)cameraPosition.z + 15);
-        int endColumn = std::min((int)mazeGenerator->getMazeSize() - 1, (int)cameraPosition.x + 15);
+        std::int64_t cameraRow = originZ + (std::int64_t)std::floor(cameraPosition.z);
+        std::int64_t cameraColumn = originX + (std::int64_t)std::floor(cameraPosition.x);
+
+        std::int64_t startRow = std::max<std::int64_t>(1, cameraRow - 15);
+        std::int64_t startColumn = std::max<std::int64_t>(1, cameraColumn - 15);
+        std::int64_t endRow = std::min<std::int64_t>(mazeSizeSigned - 1, cameraRow + 15);
+        std::int64_t endColumn = std::min<std::int64_t>(mazeSizeSigned - 1, cameraColumn + 15);
 
         //Draw walls, floor and ceiling
-        //It should draw only visible walls so we are checking if we are on empty field and then check all four neighbours
+        //It should draw only visible walls so we are checking if we are on empty field and then check its face mask
         //Wall is only visible if neighbour is filled field, if it is we move and rotate plane in the right position to make walls around field
         //Same goes for floor and ceiling
-        for (unsigned int i = startRow; i < endRow; i++)
+        for (std::int64_t i = startRow; i < endRow; i++)
         {
-            for (unsigned int j = startColumn; j < endColumn; j++)
+            for (std::int64_t j = startColumn; j < endColumn; j++)
             {
                 //Walls are rendered around empty fields so skip filled fields
-                if (mazeArray[i][j])
+                if (wallGrid != nullptr ? wallGrid->isWall(i, j) : mazeArray.get(i, j))
                 {
                     continue;
                 }
 
+                std::uint8_t faces = faceMask.get(i, j);
+
                 //Bind wall texture
                 glBindTexture(GL_TEXTURE_2D, mazeTextures[0]);
 
-                if (mazeArray[i][j-1]) //Left
+                if (faces & MazeFaceMask::LEFT) //Left
                 {
                     model = glm::mat4(1.0f);
-                    model = glm::translate(model, glm::vec3(j*1.0f, 0.0f, i*1.0f)); //Move to right position
+                    model = glm::translate(model, glm::vec3((j - originX)*1.0f, 0.0f, (i - originZ)*1.0f)); //Move to right position
                     model = glm::translate(model, glm::vec3(-0.5f, 0.0f, 0.0f)); //Move left a bit
                     model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f)); //Rotate by 90 degrees around Y
 
@@ -821,10 +1173,10 @@ int main(int argc, char* argv[])
                     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
                 }
                 
-                if (mazeArray[i][j+1]) //Right
+                if (faces & MazeFaceMask::RIGHT) //Right
                 {
                     model = glm::mat4(1.0f);
-                    model = glm::translate(model, glm::vec3(j*1.0f, 0.0f, i*1.0f)); //Move to right position
+                    model = glm::translate(model, glm::vec3((j - originX)*1.0f, 0.0f, (i - originZ)*1.0f)); //Move to right position
                     model = glm::translate(model, glm::vec3(0.5f, 0.0f, 0.0f)); //Move right a bit
                     model = glm::rotate(model, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)); //Rotate by 90 degrees around Y
 
@@ -832,10 +1184,10 @@ int main(int argc, char* argv[])
                     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
                 }
                 
-                if (mazeArray[i-1][j]) //Front
+                if (faces & MazeFaceMask::FRONT) //Front
                 {
                     model = glm::mat4(1.0f);
-                    model = glm::translate(model, glm::vec3(j*1.0f, 0.0f, i*1.0f)); //Move to right position
+                    model = glm::translate(model, glm::vec3((j - originX)*1.0f, 0.0f, (i - originZ)*1.0f)); //Move to right position
                     model = glm::translate(model, glm::vec3(0.0f, 0.0f, -0.5f)); //Move front a bit
                     model = glm::rotate(model, glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 
@@ -843,10 +1195,10 @@ int main(int argc, char* argv[])
                     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
                 }
                 
-                if (mazeArray[i+1][j]) //Back
+                if (faces & MazeFaceMask::BACK) //Back
                 {
                     model = glm::mat4(1.0f);
-                    model = glm::translate(model, glm::vec3(j*1.0f, 0.0f, i*1.0f)); //Move to right position
+                    model = glm::translate(model, glm::vec3((j - originX)*1.0f, 0.0f, (i - originZ)*1.0f)); //Move to right position
                     model = glm::translate(model, glm::vec3(0.0f, 0.0f, 0.5f)); //Move back a bit
 
                     shader.setUniformMatrix4fv("model", model);
@@ -857,7 +1209,7 @@ int main(int argc, char* argv[])
                 glBindTexture(GL_TEXTURE_2D, mazeTextures[1]);
 
                 model = glm::mat4(1.0f);
-                model = glm::translate(model, glm::vec3(j*1.0f, 0.0f, i*1.0f));
+                model = glm::translate(model, glm::vec3((j - originX)*1.0f, 0.0f, (i - originZ)*1.0f));
                 model = glm::translate(model, glm::vec3(0.0f, -0.5f, 0.0f));
                 model = glm::rotate(model, glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
 
@@ -868,7 +1220,7 @@ int main(int argc, char* argv[])
                 glBindTexture(GL_TEXTURE_2D, mazeTextures[2]);
 
                 model = glm::mat4(1.0f);
-                model = glm::translate(model, glm::vec3(j*1.0f, 0.0f, i*1.0f));
+                model = glm::translate(model, glm::vec3((j - originX)*1.0f, 0.0f, (i - originZ)*1.0f));
                 model = glm::translate(model, glm::vec3(0.0f, 0.5f, 0.0f));
                 model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
 
@@ -876,12 +1228,12 @@ int main(int argc, char* argv[])
                 glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
                 //Exit is visible so draw it
-                if (j == mazeGenerator->getEndX() && i == mazeGenerator->getEndY())
+                if (faces & MazeFaceMask::EXIT)
                 {
                     glBindTexture(GL_TEXTURE_2D, mazeTextures[3]);
 
                     model = glm::mat4(1.0f);
-                    model = glm::translate(model, glm::vec3(j*1.0f, 0.0f, i*1.0f));
+                    model = glm::translate(model, glm::vec3((j - originX)*1.0f, 0.0f, (i - originZ)*1.0f));
 
                     switch (mazeGenerator->getEndBorder())
                     {